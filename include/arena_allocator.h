@@ -0,0 +1,155 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <sys/mman.h>
+
+namespace hali {
+
+/**
+ * @brief Bump-pointer arena backed by 2 MB-aligned chunks
+ *
+ * Chunks are advised for transparent huge pages so that data laid out by one
+ * index (expert keys/values, filter bits) shares a handful of dTLB entries.
+ * Individual frees only count the bytes as dead (bytes_live()); memory is
+ * returned all at once by release(), so an arena suits data that is built
+ * once and replaced as a whole.
+ */
+class Arena {
+private:
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;  // 2 MB
+
+    std::vector<void*> chunks_;
+    char* cursor_ = nullptr;
+    size_t remaining_ = 0;
+    size_t bytes_used_ = 0;
+    size_t bytes_freed_ = 0;
+    size_t bytes_reserved_ = 0;
+
+public:
+    Arena() = default;
+    ~Arena() { release(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Allocate bytes with the given alignment from the current chunk
+     */
+    void* allocate(size_t bytes, size_t alignment) {
+        size_t pad = (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment;
+        if (cursor_ == nullptr || pad + bytes > remaining_) {
+            new_chunk(bytes + alignment);
+            pad = (alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment;
+        }
+
+        char* result = cursor_ + pad;
+        cursor_ += pad + bytes;
+        remaining_ -= pad + bytes;
+        bytes_used_ += bytes;
+        return result;
+    }
+
+    /**
+     * @brief Record bytes returned by their owner; reused only after release()
+     */
+    void deallocate(size_t bytes) {
+        bytes_freed_ += bytes;
+    }
+
+    /**
+     * @brief Return every chunk to the OS (bulk release)
+     */
+    void release() {
+        for (void* chunk : chunks_) {
+            std::free(chunk);
+        }
+        chunks_.clear();
+        cursor_ = nullptr;
+        remaining_ = 0;
+        bytes_used_ = 0;
+        bytes_freed_ = 0;
+        bytes_reserved_ = 0;
+    }
+
+    size_t bytes_used() const { return bytes_used_; }
+    size_t bytes_live() const { return bytes_used_ - bytes_freed_; }
+    size_t bytes_reserved() const { return bytes_reserved_; }
+
+private:
+    void new_chunk(size_t min_bytes) {
+        // Round up to whole huge pages; large arrays get a dedicated chunk
+        size_t size = ((min_bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+
+        void* chunk = std::aligned_alloc(HUGE_PAGE_SIZE, size);
+        if (chunk == nullptr) {
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(chunk, size, MADV_HUGEPAGE);
+#endif
+
+        chunks_.push_back(chunk);
+        cursor_ = static_cast<char*>(chunk);
+        remaining_ = size;
+        bytes_reserved_ += size;
+    }
+};
+
+/**
+ * @brief STL allocator drawing from an Arena
+ *
+ * A null arena falls back to the global heap, so containers using this
+ * allocator behave like their std::allocator counterparts when the arena
+ * is disabled.
+ */
+template<typename T>
+class ArenaAllocator {
+private:
+    template<typename U> friend class ArenaAllocator;
+
+    Arena* arena_ = nullptr;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(Arena* arena) noexcept : arena_(arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+        if (arena_ == nullptr) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (arena_ == nullptr) {
+            ::operator delete(p);
+            return;
+        }
+        // Arena memory is reclaimed in bulk by Arena::release()
+        arena_->deallocate(n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ == other.arena_;
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ != other.arena_;
+    }
+};
+
+} // namespace hali
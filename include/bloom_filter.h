@@ -3,6 +3,7 @@
 #include <vector>
 #include <cstdint>
 #include <cmath>
+#include <memory>
 #include "hash_utils.h"
 
 namespace hali {
@@ -13,10 +14,13 @@ namespace hali {
  * Uses k=7 hash functions with double hashing technique
  * Memory: bits_per_key bits per inserted element
  * False positive rate: ~1% with 10 bits/key
+ *
+ * @tparam Allocator Allocator for the bit array (lets owners place it in an arena)
  */
-class BloomFilter {
+template<typename Allocator = std::allocator<uint64_t>>
+class BasicBloomFilter {
 private:
-    std::vector<uint64_t> bits_;  // Bit array (packed in 64-bit words)
+    std::vector<uint64_t, Allocator> bits_;  // Bit array (packed in 64-bit words)
     size_t num_bits_;              // Total bits
     size_t num_hash_functions_;    // k hash functions
     size_t num_inserted_;          // Count of inserted elements
@@ -27,9 +31,11 @@ public:
      *
      * @param expected_elements Expected number of elements to insert
      * @param bits_per_key Bits allocated per key (10 = ~1% FPR)
+     * @param alloc Allocator for the bit array
      */
-    BloomFilter(size_t expected_elements = 1000, size_t bits_per_key = 10)
-        : num_inserted_(0) {
+    BasicBloomFilter(size_t expected_elements = 1000, size_t bits_per_key = 10,
+                     const Allocator& alloc = Allocator())
+        : bits_(alloc), num_inserted_(0) {
 
         num_bits_ = expected_elements * bits_per_key;
 
@@ -118,4 +124,6 @@ public:
     size_t num_hash_functions() const { return num_hash_functions_; }
 };
 
+using BloomFilter = BasicBloomFilter<>;
+
 } // namespace hali
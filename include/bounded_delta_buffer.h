@@ -0,0 +1,122 @@
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <cstddef>
+
+namespace hali {
+
+/**
+ * @brief Bounded hashed write buffer in front of a static sorted array
+ *
+ * Learned indexes that store their data as sorted keys/values arrays
+ * (RMIIndex) absorb updates here: an entry holds either a value
+ * (insert, or re-insert of an erased base key) or a tombstone (erase of a
+ * base key). Point operations are O(1) hash probes. Once size() reaches
+ * capacity() the owner calls merge_into() to fold every entry into its
+ * arrays in one O(n + b log b) pass and retrains, so each buffered update
+ * costs O(n / capacity) amortized instead of a linear buffer scan.
+ */
+template<typename KeyType, typename ValueType>
+class BoundedDeltaBuffer {
+private:
+    // Entry without a value = tombstone for a key of the base array
+    phmap::flat_hash_map<KeyType, std::optional<ValueType>> entries_;
+
+    double fraction_;       // Capacity as a share of the base array
+    size_t min_capacity_;
+    size_t capacity_;
+    size_t num_merges_ = 0;
+
+public:
+    /**
+     * @param fraction Capacity relative to the base array size after each merge
+     * @param min_capacity Lower bound on the capacity (small or empty bases)
+     */
+    explicit BoundedDeltaBuffer(double fraction = 0.01, size_t min_capacity = 1024)
+        : fraction_(fraction), min_capacity_(std::max(size_t(1), min_capacity)),
+          capacity_(min_capacity_) {}
+
+    /**
+     * @brief Entry for key: nullptr if absent, else a value or a tombstone (empty optional)
+     */
+    const std::optional<ValueType>* lookup(const KeyType& key) const {
+        auto it = entries_.find(key);
+        return it == entries_.end() ? nullptr : &it->second;
+    }
+
+    void put(const KeyType& key, const ValueType& value) {
+        entries_[key] = value;
+    }
+
+    void put_tombstone(const KeyType& key) {
+        entries_[key] = std::nullopt;
+    }
+
+    void remove(const KeyType& key) {
+        entries_.erase(key);
+    }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    bool full() const { return entries_.size() >= capacity_; }
+    size_t capacity() const { return capacity_; }
+    size_t num_merges() const { return num_merges_; }
+
+    /**
+     * @brief Drop every entry and size the capacity for a base of base_size keys
+     */
+    void reset(size_t base_size) {
+        entries_.clear();
+        capacity_ = std::max(min_capacity_, static_cast<size_t>(base_size * fraction_));
+    }
+
+    /**
+     * @brief Fold every entry into sorted keys/values and reset for the new size
+     *
+     * Values override base entries with the same key, tombstones drop them.
+     */
+    void merge_into(std::vector<KeyType>& keys, std::vector<ValueType>& values) {
+        std::vector<std::pair<KeyType, std::optional<ValueType>>> delta(entries_.begin(), entries_.end());
+        std::sort(delta.begin(), delta.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<KeyType> merged_keys;
+        std::vector<ValueType> merged_values;
+        merged_keys.reserve(keys.size() + delta.size());
+        merged_values.reserve(keys.size() + delta.size());
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys.size() || j < delta.size()) {
+            if (j == delta.size() || (i < keys.size() && keys[i] < delta[j].first)) {
+                merged_keys.push_back(keys[i]);
+                merged_values.push_back(values[i]);
+                ++i;
+                continue;
+            }
+            if (i < keys.size() && keys[i] == delta[j].first) {
+                ++i;  // Overridden or erased
+            }
+            if (delta[j].second.has_value()) {
+                merged_keys.push_back(delta[j].first);
+                merged_values.push_back(*delta[j].second);
+            }
+            ++j;
+        }
+
+        keys = std::move(merged_keys);
+        values = std::move(merged_values);
+        reset(keys.size());
+        num_merges_++;
+    }
+
+    size_t memory_footprint() const {
+        // Slots hold key + optional value; one control byte per slot
+        return entries_.capacity() * (sizeof(KeyType) + sizeof(std::optional<ValueType>) + 1);
+    }
+};
+
+} // namespace hali
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <map>
+#include <string>
 
 namespace hali {
 
@@ -229,6 +231,47 @@ public:
 
         return keys;
     }
+
+    /**
+     * @brief Datasets benchmarked by the simulator, keyed by display name
+     * @param n Dataset size
+     * @param which "all" or one lowercase dataset name (e.g. "uniform")
+     */
+    static std::map<std::string, std::vector<uint64_t>> generate_benchmark_datasets(
+        size_t n, const std::string& which = "all") {
+
+        std::map<std::string, std::vector<uint64_t>> datasets;
+        if (which == "all" || which == "lognormal") {
+            datasets["Lognormal"] = generate_lognormal(n);
+        }
+        if (which == "all" || which == "zipfian") {
+            datasets["Zipfian"] = generate_zipfian(n);
+        }
+        if (which == "all" || which == "clustered") {
+            datasets["Clustered"] = generate_clustered(n / 10, 10);
+        }
+        if (which == "all" || which == "sequential") {
+            datasets["Sequential"] = generate_sequential_with_gaps(n);
+        }
+        if (which == "all" || which == "mixed") {
+            datasets["Mixed"] = generate_mixed(n);
+        }
+        if (which == "all" || which == "uniform") {
+            datasets["Uniform"] = generate_uniform(n);
+        }
+        return datasets;
+    }
+
+    /**
+     * @brief Small datasets checked by the validation suite, keyed by display name
+     */
+    static std::map<std::string, std::vector<uint64_t>> generate_validation_datasets() {
+        return {
+            {"Clustered", generate_clustered(1000, 5)},
+            {"Sequential", generate_sequential_with_gaps(10000)},
+            {"Uniform", generate_uniform(5000)},
+        };
+    }
 };
 
 } // namespace hali
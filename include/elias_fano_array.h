@@ -0,0 +1,202 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+namespace hali {
+
+/**
+ * @brief Elias-Fano encoded sorted (non-decreasing) sequence of integers
+ *
+ * Each value, taken as an offset from the minimum, is split into its low
+ * LOW bits, packed into a fixed-width array, and its high part, stored in
+ * unary in a bit vector: element i sets bit high_i + i, so the high parts
+ * form buckets separated by zeros. With LOW = floor(log2(range / n)) this
+ * takes about LOW + 2 bits per element.
+ *
+ * Random access goes through a select index sampling every SELECT_SAMPLE-th
+ * one bit. lower_bound() starts from a position known to be at or before the
+ * answer (a PGM prediction), skips zeros up to the key's high bucket and
+ * compares low bits only inside that bucket.
+ */
+template<typename T>
+class EliasFanoArray {
+public:
+    static constexpr size_t SELECT_SAMPLE = 256;
+
+private:
+    using U = typename std::make_unsigned<T>::type;
+
+    T min_ = 0;
+    U max_offset_ = 0;
+    uint8_t low_bits_ = 0;
+    size_t size_ = 0;
+
+    std::vector<uint64_t> lower_;     // size_ fields of low_bits_ bits
+    std::vector<uint64_t> upper_;     // Unary high parts
+    std::vector<size_t> select_;      // Bit position of every SELECT_SAMPLE-th one
+
+public:
+    EliasFanoArray() = default;
+
+    template<typename Container>
+    explicit EliasFanoArray(const Container& sorted) : size_(sorted.size()) {
+        if (size_ == 0) return;
+
+        min_ = sorted.front();
+        max_offset_ = static_cast<U>(sorted.back() - min_);
+        U ratio = max_offset_ / size_;
+        while (low_bits_ < 63 && (ratio >> (low_bits_ + 1)) != 0) {
+            low_bits_++;
+        }
+
+        size_t upper_bits = size_ + static_cast<size_t>(max_offset_ >> low_bits_) + 1;
+        upper_.assign(upper_bits / 64 + 1, 0);
+        lower_.assign((size_ * low_bits_ + 63) / 64 + 1, 0);
+        select_.reserve(size_ / SELECT_SAMPLE + 1);
+
+        for (size_t i = 0; i < size_; ++i) {
+            U offset = static_cast<U>(sorted[i] - min_);
+            size_t bit = static_cast<size_t>(offset >> low_bits_) + i;
+            upper_[bit / 64] |= uint64_t(1) << (bit % 64);
+            if (i % SELECT_SAMPLE == 0) {
+                select_.push_back(bit);
+            }
+
+            if (low_bits_ > 0) {
+                uint64_t low = static_cast<uint64_t>(offset) & low_mask();
+                size_t bitpos = i * low_bits_;
+                unsigned shift = bitpos % 64;
+                lower_[bitpos / 64] |= low << shift;
+                if (shift + low_bits_ > 64) {
+                    lower_[bitpos / 64 + 1] |= low >> (64 - shift);
+                }
+            }
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    uint8_t low_bits() const { return low_bits_; }
+
+    /**
+     * @brief Element i
+     */
+    T get(size_t i) const {
+        U high = static_cast<U>(select1(i) - i);
+        return min_ + static_cast<T>((high << low_bits_) | static_cast<U>(low(i)));
+    }
+
+    /**
+     * @brief First position >= from whose element is >= key
+     *
+     * Cost grows with the number of elements between from and the answer,
+     * so from should be a close lower bound (e.g. a PGM search window's lo).
+     * @return Position in [from, size()], size() if every element is < key
+     */
+    size_t lower_bound(size_t from, T key) const {
+        if (from >= size_ || key > max_value()) return size_;
+        if (key <= min_) return from;
+
+        U offset = static_cast<U>(key - min_);
+        size_t bucket = static_cast<size_t>(offset >> low_bits_);
+        uint64_t key_low = static_cast<uint64_t>(offset) & low_mask();
+
+        size_t bit = select1(from);
+        size_t high = bit - from;
+        if (high > bucket) return from;
+
+        // First element of the key's bucket: pass (bucket - high) more zeros
+        if (high < bucket) {
+            bit = skip_zeros(bit, bucket - high);
+        }
+        size_t i = bit - bucket;
+
+        // Same high part: compare low bits until the bucket's terminating zero
+        while (i < size_ && test(bit)) {
+            if (low(i) >= key_low) return i;
+            ++i;
+            ++bit;
+        }
+        return i;
+    }
+
+    size_t memory_footprint() const {
+        return lower_.capacity() * sizeof(uint64_t) +
+               upper_.capacity() * sizeof(uint64_t) +
+               select_.capacity() * sizeof(size_t);
+    }
+
+private:
+    T max_value() const {
+        return min_ + static_cast<T>(max_offset_);
+    }
+
+    uint64_t low_mask() const {
+        return low_bits_ == 0 ? 0 : (~uint64_t(0) >> (64 - low_bits_));
+    }
+
+    bool test(size_t bit) const {
+        return (upper_[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    uint64_t low(size_t i) const {
+        if (low_bits_ == 0) return 0;
+        size_t bitpos = i * low_bits_;
+        unsigned shift = bitpos % 64;
+        uint64_t v = lower_[bitpos / 64] >> shift;
+        if (shift + low_bits_ > 64) {
+            v |= lower_[bitpos / 64 + 1] << (64 - shift);
+        }
+        return v & low_mask();
+    }
+
+    /**
+     * @brief Position of the r-th (0-based) set bit of word
+     */
+    static unsigned select_in_word(uint64_t word, size_t r) {
+        for (size_t k = 0; k < r; ++k) {
+            word &= word - 1;
+        }
+        return static_cast<unsigned>(__builtin_ctzll(word));
+    }
+
+    /**
+     * @brief Bit position of the i-th one in upper_ (element i)
+     */
+    size_t select1(size_t i) const {
+        size_t bit = select_[i / SELECT_SAMPLE];
+        size_t r = i % SELECT_SAMPLE;
+        size_t w = bit / 64;
+        uint64_t word = upper_[w] & (~uint64_t(0) << (bit % 64));
+        for (;;) {
+            size_t ones = static_cast<size_t>(__builtin_popcountll(word));
+            if (r < ones) {
+                return w * 64 + select_in_word(word, r);
+            }
+            r -= ones;
+            word = upper_[++w];
+        }
+    }
+
+    /**
+     * @brief Position just past the count-th zero after bit
+     */
+    size_t skip_zeros(size_t bit, size_t count) const {
+        size_t w = bit / 64;
+        uint64_t zeros = ~upper_[w] & (~uint64_t(0) << (bit % 64));
+        for (;;) {
+            size_t n = static_cast<size_t>(__builtin_popcountll(zeros));
+            if (count <= n) {
+                return w * 64 + select_in_word(zeros, count - 1) + 1;
+            }
+            count -= n;
+            zeros = ~upper_[++w];
+        }
+    }
+};
+
+} // namespace hali
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+namespace hali {
+
+/**
+ * @brief Frame-of-reference + bitpacked array of integers in independent blocks
+ *
+ * Every BLOCK consecutive values are stored as a base (the block minimum)
+ * and fixed-width offsets from it, packed into 64-bit words. A block
+ * decodes without touching its neighbours, and single elements can be
+ * extracted directly, so a lookup never decompresses more than one block.
+ * Sorted inputs (expert keys) compress best: the offsets only span the
+ * key range of one block.
+ */
+template<typename T>
+class FORBlockArray {
+public:
+    static constexpr size_t BLOCK = 128;
+
+private:
+    struct BlockHeader {
+        T base;               // Minimum of the block
+        uint32_t word_offset; // First word of the block in words_
+        uint8_t bits;         // Width of each packed offset (0-64)
+    };
+
+    std::vector<BlockHeader> blocks_;
+    std::vector<uint64_t> words_;
+    size_t size_ = 0;
+
+public:
+    FORBlockArray() = default;
+
+    template<typename Container>
+    explicit FORBlockArray(const Container& src) : size_(src.size()) {
+        using U = typename std::make_unsigned<T>::type;
+        blocks_.reserve((size_ + BLOCK - 1) / BLOCK);
+
+        for (size_t begin = 0; begin < size_; begin += BLOCK) {
+            size_t count = std::min(BLOCK, size_ - begin);
+            T base = *std::min_element(src.begin() + begin, src.begin() + begin + count);
+
+            U max_delta = 0;
+            for (size_t j = 0; j < count; ++j) {
+                max_delta = std::max(max_delta, static_cast<U>(src[begin + j] - base));
+            }
+            uint8_t bits = 0;
+            while (bits < 64 && (max_delta >> bits) != 0) {
+                bits++;
+            }
+
+            BlockHeader header{base, static_cast<uint32_t>(words_.size()), bits};
+            words_.resize(words_.size() + (count * bits + 63) / 64, 0);
+            for (size_t j = 0; j < count && bits > 0; ++j) {
+                uint64_t delta = static_cast<U>(src[begin + j] - base);
+                size_t bitpos = j * bits;
+                size_t w = header.word_offset + bitpos / 64;
+                unsigned shift = bitpos % 64;
+                words_[w] |= delta << shift;
+                if (shift + bits > 64) {
+                    words_[w + 1] |= delta >> (64 - shift);
+                }
+            }
+            blocks_.push_back(header);
+        }
+        words_.shrink_to_fit();
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t num_blocks() const { return blocks_.size(); }
+
+    /**
+     * @brief Extract element i without decoding its block
+     */
+    T get(size_t i) const {
+        const BlockHeader& header = blocks_[i / BLOCK];
+        return header.base + static_cast<T>(extract(header, i % BLOCK));
+    }
+
+    /**
+     * @brief Decode block b into out
+     * @return Number of elements written (BLOCK except for the last block)
+     */
+    size_t decode_block(size_t b, T* out) const {
+        const BlockHeader& header = blocks_[b];
+        size_t count = std::min(BLOCK, size_ - b * BLOCK);
+        for (size_t j = 0; j < count; ++j) {
+            out[j] = header.base + static_cast<T>(extract(header, j));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Decode every element into out (size() elements)
+     */
+    void decode_all(T* out) const {
+        for (size_t b = 0; b < blocks_.size(); ++b) {
+            decode_block(b, out + b * BLOCK);
+        }
+    }
+
+    /**
+     * @brief First position in [lo, hi) whose element is >= key (sorted arrays only)
+     *
+     * Block bases narrow [lo, hi) to one block, which is the only one decoded.
+     * @return Position in [lo, hi], hi if every element in range is < key
+     */
+    size_t lower_bound(size_t lo, size_t hi, T key) const {
+        if (lo >= hi) return hi;
+
+        // Last block in the window whose base is < key
+        size_t b_lo = lo / BLOCK;
+        size_t b_hi = (hi - 1) / BLOCK;
+        auto it = std::lower_bound(blocks_.begin() + b_lo, blocks_.begin() + b_hi + 1, key,
+            [](const BlockHeader& header, T k) { return header.base < k; });
+        size_t b = (it == blocks_.begin() + b_lo) ? b_lo : static_cast<size_t>(it - blocks_.begin()) - 1;
+
+        T decoded[BLOCK];
+        size_t count = decode_block(b, decoded);
+        size_t first = b * BLOCK;
+        size_t from = std::max(lo, first) - first;
+        size_t to = std::min(hi, first + count) - first;
+        size_t pos = std::lower_bound(decoded + from, decoded + to, key) - decoded;
+
+        // Past the end of block b: the next block starts at or above key
+        return std::min(hi, first + pos);
+    }
+
+    size_t memory_footprint() const {
+        return blocks_.capacity() * sizeof(BlockHeader) + words_.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    uint64_t extract(const BlockHeader& header, size_t j) const {
+        if (header.bits == 0) return 0;
+        size_t bitpos = j * header.bits;
+        size_t w = header.word_offset + bitpos / 64;
+        unsigned shift = bitpos % 64;
+        uint64_t v = words_[w] >> shift;
+        if (shift + header.bits > 64) {
+            v |= words_[w + 1] << (64 - shift);
+        }
+        return header.bits == 64 ? v : (v & ((uint64_t(1) << header.bits) - 1));
+    }
+};
+
+} // namespace hali
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace hali {
+
+/**
+ * @brief Small set-associative cache of recent positive lookups
+ *
+ * Keys hash (Fibonacci hashing) to one set of WAYS entries kept in
+ * most-recently-used order: a hit moves its entry to the front, a fill
+ * evicts the last one. A set of 4 x uint64 keys and values fits in two
+ * cache lines, so a probe costs one multiply and at most WAYS compares.
+ *
+ * Only keys known to be present are cached; owners must invalidate() a
+ * key whenever its entry may change (insert, erase).
+ */
+template<typename KeyType, typename ValueType, size_t WAYS = 4>
+class HotKeyCache {
+private:
+    struct alignas(64) Set {
+        KeyType keys[WAYS];
+        ValueType values[WAYS];
+        size_t count = 0;  // Valid ways, most recently used first
+    };
+
+    std::vector<Set> sets_;
+    unsigned shift_;  // 64 - log2(number of sets)
+
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    size_t invalidations_ = 0;
+
+public:
+    /**
+     * @param capacity Minimum number of cached entries (sets rounded up to a power of two)
+     */
+    explicit HotKeyCache(size_t capacity = 4096) {
+        size_t num_sets = 1;
+        unsigned bits = 0;
+        while (num_sets * WAYS < capacity) {
+            num_sets <<= 1;
+            bits++;
+        }
+        sets_.resize(num_sets);
+        shift_ = 64 - bits;
+    }
+
+    /**
+     * @brief Probe for a cached value, promoting it to most recently used
+     * @return Pointer to the value (valid until the next cache call), or nullptr
+     */
+    const ValueType* lookup(const KeyType& key) {
+        Set& set = set_for(key);
+        for (size_t i = 0; i < set.count; ++i) {
+            if (set.keys[i] == key) {
+                ValueType value = set.values[i];
+                for (size_t j = i; j > 0; --j) {
+                    set.keys[j] = set.keys[j - 1];
+                    set.values[j] = set.values[j - 1];
+                }
+                set.keys[0] = key;
+                set.values[0] = value;
+                hits_++;
+                return &set.values[0];
+            }
+        }
+        misses_++;
+        return nullptr;
+    }
+
+    /**
+     * @brief Cache a present key as most recently used (evicts the set's LRU entry)
+     */
+    void fill(const KeyType& key, const ValueType& value) {
+        Set& set = set_for(key);
+        size_t last = (set.count < WAYS) ? set.count++ : WAYS - 1;
+        for (size_t j = last; j > 0; --j) {
+            set.keys[j] = set.keys[j - 1];
+            set.values[j] = set.values[j - 1];
+        }
+        set.keys[0] = key;
+        set.values[0] = value;
+    }
+
+    /**
+     * @brief Drop a key's entry if cached
+     */
+    void invalidate(const KeyType& key) {
+        Set& set = set_for(key);
+        for (size_t i = 0; i < set.count; ++i) {
+            if (set.keys[i] == key) {
+                for (size_t j = i + 1; j < set.count; ++j) {
+                    set.keys[j - 1] = set.keys[j];
+                    set.values[j - 1] = set.values[j];
+                }
+                set.count--;
+                invalidations_++;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Drop every entry (statistics are kept)
+     */
+    void clear() {
+        for (auto& set : sets_) {
+            set.count = 0;
+        }
+    }
+
+    void reset_stats() {
+        hits_ = 0;
+        misses_ = 0;
+        invalidations_ = 0;
+    }
+
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+    size_t invalidations() const { return invalidations_; }
+
+    double hit_rate() const {
+        size_t probes = hits_ + misses_;
+        return probes == 0 ? 0.0 : static_cast<double>(hits_) / probes;
+    }
+
+    size_t capacity() const { return sets_.size() * WAYS; }
+
+    size_t memory_footprint() const {
+        return sets_.capacity() * sizeof(Set);
+    }
+
+private:
+    Set& set_for(const KeyType& key) {
+        // A single set has shift_ == 64, which a shift cannot express
+        uint64_t h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL;
+        return sets_[shift_ >= 64 ? 0 : (h >> shift_)];
+    }
+};
+
+} // namespace hali
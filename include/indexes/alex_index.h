@@ -1,8 +1,11 @@
 #pragma once
 
 #include "index_interface.h"
-#include "alex_map.h"
+#include "alex.h"
 #include <cstring>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
 
 namespace hali {
 
@@ -14,9 +17,11 @@ namespace hali {
 template<typename KeyType, typename ValueType>
 class ALEXIndex : public IndexInterface<KeyType, ValueType> {
 private:
-    alex::AlexMap<KeyType, ValueType> alex_;
+    alex::Alex<KeyType, ValueType> alex_;
 
 public:
+    using Stats = typename alex::Alex<KeyType, ValueType>::Stats;
+
     ALEXIndex() = default;
 
     bool insert(const KeyType& key, const ValueType& value) override {
@@ -25,9 +30,8 @@ public:
     }
 
     std::optional<ValueType> find(const KeyType& key) const override {
-        auto it = alex_.find(key);
-        if (it != alex_.cend()) {
-            return it.payload();
+        if (const ValueType* payload = alex_.get_payload(key)) {
+            return *payload;
         }
         return std::nullopt;
     }
@@ -53,12 +57,16 @@ public:
             pairs.emplace_back(keys[i], values[i]);
         }
 
-        // Sort by key (ALEX requires sorted data for bulk load)
-        std::sort(pairs.begin(), pairs.end(),
-                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        // Sort by key (ALEX requires sorted, unique keys for bulk load);
+        // of equal keys the last one loaded wins
+        std::stable_sort(pairs.begin(), pairs.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        auto last = std::unique(pairs.rbegin(), pairs.rend(),
+                                [](const auto& a, const auto& b) { return a.first == b.first; });
+        pairs.erase(pairs.begin(), last.base());
 
         // Bulk load into ALEX
-        alex_.bulk_load(pairs.data(), pairs.size());
+        alex_.bulk_load(pairs.data(), static_cast<int>(pairs.size()));
     }
 
     size_t size() const override {
@@ -66,26 +74,8 @@ public:
     }
 
     size_t memory_footprint() const override {
-        // Get ALEX statistics which include memory usage
-        const auto& stats = alex_.get_stats();
-
-        // ALEX stats include:
-        // - num_keys: number of keys
-        // - num_model_nodes: number of internal nodes with linear models
-        // - num_data_nodes: number of leaf nodes
-        // Each model node: ~64 bytes (model parameters + metadata)
-        // Each data node: variable size based on capacity
-
-        size_t model_node_size = 64;
-        size_t data_node_overhead = 32; // metadata per data node
-        size_t pair_size = sizeof(KeyType) + sizeof(ValueType);
-
-        size_t total =
-            stats.num_model_nodes * model_node_size +
-            stats.num_data_nodes * data_node_overhead +
-            stats.num_keys * pair_size;
-
-        return total;
+        // ALEX's own accounting: model nodes, and data nodes including gaps
+        return static_cast<size_t>(alex_.model_size()) + static_cast<size_t>(alex_.data_size());
     }
 
     std::string name() const override {
@@ -95,6 +85,13 @@ public:
     void clear() override {
         alex_.clear();
     }
+
+    /**
+     * @brief ALEX's node counts and structural modification counters
+     */
+    const Stats& stats() const {
+        return alex_.get_stats();
+    }
 };
 
 } // namespace hali
@@ -1,14 +1,24 @@
 #pragma once
 
 #include "index_interface.h"
+#include "static_art.h"
 #include <art/map.h>
 #include <cstring>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
 
 namespace hali {
 
 /**
  * @brief Adaptive Radix Tree index using justinasvd/art_map
  * Cache-efficient trie structure optimized for sorted keys
+ *
+ * load() builds a StaticART bottom-up over the sorted keys in one pass,
+ * every inner node created with its final type. art::map has no bulk
+ * interface, so keys inserted after load() go into an art::map alongside;
+ * erases of loaded keys set a bit instead of restructuring the static tree.
  */
 template<typename KeyType, typename ValueType>
 class ARTIndex : public IndexInterface<KeyType, ValueType> {
@@ -16,17 +26,45 @@ private:
     static_assert(std::is_integral<KeyType>::value,
                   "ARTIndex requires integral key type");
 
+    // Bulk-loaded keys (sorted, unique) and the tree over them
+    std::vector<KeyType> keys_;
+    std::vector<ValueType> values_;
+    std::vector<bool> erased_;
+    StaticART<KeyType> base_;
+
+    // Keys inserted since load()
     art::map<KeyType, ValueType> tree_;
+    size_t size_ = 0;
 
 public:
     ARTIndex() = default;
 
     bool insert(const KeyType& key, const ValueType& value) override {
+        size_t pos = base_.find(key, keys_.data());
+        if (pos != StaticART<KeyType>::NOT_FOUND) {
+            if (!erased_[pos]) {
+                return false; // Key already exists
+            }
+            erased_[pos] = false;
+            values_[pos] = value;
+            size_++;
+            return true;
+        }
+
         auto result = tree_.insert({key, value});
+        if (result.second) {
+            size_++;
+        }
         return result.second; // true if inserted, false if already exists
     }
 
     std::optional<ValueType> find(const KeyType& key) const override {
+        size_t pos = base_.find(key, keys_.data());
+        if (pos != StaticART<KeyType>::NOT_FOUND) {
+            if (erased_[pos]) return std::nullopt;
+            return values_[pos];
+        }
+
         auto it = tree_.find(key);
         if (it != tree_.end()) {
             return it->second;
@@ -35,7 +73,19 @@ public:
     }
 
     bool erase(const KeyType& key) override {
-        return tree_.erase(key) > 0;
+        size_t pos = base_.find(key, keys_.data());
+        if (pos != StaticART<KeyType>::NOT_FOUND) {
+            if (erased_[pos]) return false;
+            erased_[pos] = true;
+            size_--;
+            return true;
+        }
+
+        if (tree_.erase(key) > 0) {
+            size_--;
+            return true;
+        }
+        return false;
     }
 
     void load(const std::vector<KeyType>& keys,
@@ -44,28 +94,50 @@ public:
             throw std::invalid_argument("Keys and values size mismatch");
         }
 
-        tree_.clear();
-        for (size_t i = 0; i < keys.size(); ++i) {
-            tree_[keys[i]] = values[i];
+        // Sort by keys; of equal keys the last one loaded wins
+        std::vector<size_t> indices(keys.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::stable_sort(indices.begin(), indices.end(),
+                         [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+        keys_.clear();
+        values_.clear();
+        keys_.reserve(keys.size());
+        values_.reserve(values.size());
+        for (size_t idx : indices) {
+            if (!keys_.empty() && keys_.back() == keys[idx]) {
+                values_.back() = values[idx];
+                continue;
+            }
+            keys_.push_back(keys[idx]);
+            values_.push_back(values[idx]);
         }
+
+        base_ = StaticART<KeyType>(keys_.data(), keys_.size());
+        erased_.assign(keys_.size(), false);
+        tree_.clear();
+        size_ = keys_.size();
     }
 
     size_t size() const override {
-        return tree_.size();
+        return size_;
     }
 
     size_t memory_footprint() const override {
-        // ART has variable node sizes: Node4, Node16, Node48, Node256
-        // Approximate based on tree depth and fanout
+        size_t base_overhead = sizeof(*this);
 
-        size_t base_overhead = sizeof(tree_);
-        size_t leaf_size = (sizeof(KeyType) + sizeof(ValueType)) * tree_.size();
+        // Bulk-loaded part: leaves are the sorted arrays, inner nodes measured
+        size_t base_size = keys_.capacity() * sizeof(KeyType) +
+                           values_.capacity() * sizeof(ValueType) +
+                           erased_.capacity() / 8 +
+                           base_.memory_footprint();
 
+        // art::map has variable node sizes: Node4, Node16, Node48, Node256
         // Internal node overhead (typically 20-30% for ART)
-        // ART is more space-efficient than B+Tree but less than hash
+        size_t leaf_size = (sizeof(KeyType) + sizeof(ValueType)) * tree_.size();
         size_t internal_overhead = leaf_size * 0.25;
 
-        return base_overhead + leaf_size + internal_overhead;
+        return base_overhead + base_size + leaf_size + internal_overhead;
     }
 
     std::string name() const override {
@@ -73,7 +145,12 @@ public:
     }
 
     void clear() override {
+        keys_.clear();
+        values_.clear();
+        erased_.clear();
+        base_ = StaticART<KeyType>();
         tree_.clear();
+        size_ = 0;
     }
 };
 
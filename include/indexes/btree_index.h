@@ -3,6 +3,10 @@
 #include "index_interface.h"
 #include <parallel_hashmap/btree.h>
 #include <cstring>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
 
 namespace hali {
 
@@ -35,6 +39,15 @@ public:
         return tree_.erase(key) > 0;
     }
 
+    /**
+     * @brief Bulk load in key order
+     *
+     * Every pair is inserted with an end() hint, so the tree is appended to
+     * from its rightmost leaf without a root-to-leaf descent. phmap's btree
+     * biases a split towards the side being inserted into, so appending in
+     * order leaves full nodes behind instead of the half-full nodes of
+     * random-order inserts. Duplicate keys keep the last value, as before.
+     */
     void load(const std::vector<KeyType>& keys,
               const std::vector<ValueType>& values) override {
         if (keys.size() != values.size()) {
@@ -42,8 +55,19 @@ public:
         }
 
         tree_.clear();
-        for (size_t i = 0; i < keys.size(); ++i) {
-            tree_[keys[i]] = values[i];
+        if (std::is_sorted(keys.begin(), keys.end())) {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                append(keys[i], values[i]);
+            }
+            return;
+        }
+
+        std::vector<size_t> indices(keys.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::stable_sort(indices.begin(), indices.end(),
+                         [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+        for (size_t idx : indices) {
+            append(keys[idx], values[idx]);
         }
     }
 
@@ -71,6 +95,21 @@ public:
     void clear() override {
         tree_.clear();
     }
+
+private:
+    /**
+     * @brief Insert a key >= every key in the tree at the rightmost position
+     */
+    void append(const KeyType& key, const ValueType& value) {
+        if (!tree_.empty()) {
+            auto last = std::prev(tree_.end());
+            if (last->first == key) {
+                last->second = value;
+                return;
+            }
+        }
+        tree_.insert(tree_.end(), {key, value});
+    }
 };
 
 } // namespace hali
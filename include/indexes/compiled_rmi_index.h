@@ -0,0 +1,139 @@
+#pragma once
+
+#include "index_interface.h"
+#include "indexes/rmi_index.h"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <cstdint>
+
+namespace hali {
+
+/**
+ * @brief Leaf of a code-generated RMI (see RMIIndex::emit_header())
+ */
+struct CompiledRMILeaf {
+    double slope;
+    double intercept;
+    int64_t min_error;
+    int64_t max_error;
+};
+
+/**
+ * @brief Read-only RMI whose model is compiled in for one fixed dataset
+ *
+ * Model is a struct generated by rmi_codegen: leaf parameters are constexpr
+ * data and Model::search_bound() is straight-line code with the root's
+ * constants folded in, so a lookup has no model pointer, no topology switch
+ * and no runtime-sized arrays. load() accepts only the exact keys the model
+ * was trained on (checked by size and fingerprint).
+ *
+ * Updates are rejected: insert() and erase() return false.
+ *
+ * @tparam Model Generated model struct (hali::compiled_rmi::...)
+ */
+template<typename Model, typename ValueType = uint64_t>
+class CompiledRMIIndex : public IndexInterface<typename Model::key_type, ValueType> {
+public:
+    using KeyType = typename Model::key_type;
+
+private:
+    std::vector<KeyType> keys_;
+    std::vector<ValueType> values_;
+
+public:
+    CompiledRMIIndex() = default;
+
+    bool insert(const KeyType&, const ValueType&) override {
+        return false;  // Model is fixed at compile time
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const override {
+        if (keys_.empty()) return std::nullopt;
+
+        size_t lo, hi;
+        Model::search_bound(key, lo, hi);
+        auto it = std::lower_bound(keys_.begin() + lo, keys_.begin() + hi, key);
+        if (it != keys_.begin() + hi && *it == key) {
+            return values_[std::distance(keys_.begin(), it)];
+        }
+        return std::nullopt;
+    }
+
+    bool erase(const KeyType&) override {
+        return false;  // Model is fixed at compile time
+    }
+
+    void load(const std::vector<KeyType>& keys,
+              const std::vector<ValueType>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values size mismatch");
+        }
+
+        std::vector<size_t> indices(keys.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::sort(indices.begin(), indices.end(),
+                  [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+        std::vector<KeyType> sorted_keys(keys.size());
+        std::vector<ValueType> sorted_values(values.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            sorted_keys[i] = keys[indices[i]];
+            sorted_values[i] = values[indices[i]];
+        }
+
+        if (!matches_sorted(sorted_keys)) {
+            throw std::invalid_argument(std::string("Keys do not match the ") + Model::DATASET +
+                                        " dataset compiled into this RMI");
+        }
+
+        // Generated and trained arithmetic must agree on every key (e.g. FMA contraction)
+        for (size_t i = 0; i < sorted_keys.size(); ++i) {
+            size_t lo, hi;
+            Model::search_bound(sorted_keys[i], lo, hi);
+            if (i < lo || i >= hi) {
+                throw std::runtime_error(std::string("Compiled RMI for ") + Model::DATASET +
+                                         " misses a key; regenerate it with this compiler");
+            }
+        }
+
+        keys_ = std::move(sorted_keys);
+        values_ = std::move(sorted_values);
+    }
+
+    size_t size() const override {
+        return keys_.size();
+    }
+
+    size_t memory_footprint() const override {
+        return keys_.capacity() * sizeof(KeyType) +
+               values_.capacity() * sizeof(ValueType) +
+               sizeof(Model::LEAVES);
+    }
+
+    std::string name() const override {
+        return "RMI(compiled)";
+    }
+
+    void clear() override {
+        keys_.clear();
+        values_.clear();
+    }
+
+    /**
+     * @brief Whether keys (any order) are the dataset Model was generated for
+     */
+    static bool matches(std::vector<KeyType> keys) {
+        std::sort(keys.begin(), keys.end());
+        return matches_sorted(keys);
+    }
+
+private:
+    static bool matches_sorted(const std::vector<KeyType>& sorted_keys) {
+        return sorted_keys.size() == Model::NUM_KEYS &&
+               rmi_key_fingerprint(sorted_keys) == Model::KEY_FINGERPRINT;
+    }
+};
+
+} // namespace hali
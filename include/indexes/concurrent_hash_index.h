@@ -0,0 +1,90 @@
+#pragma once
+
+#include "index_interface.h"
+#include <parallel_hashmap/phmap.h>
+#include <shared_mutex>
+#include <stdexcept>
+
+namespace hali {
+
+/**
+ * @brief Thread-safe hash table index using phmap::parallel_flat_hash_map
+ *
+ * The table is split into 2^SubmapBits flat_hash_map submaps, each guarded
+ * by its own reader-writer lock; a key's hash picks its submap, so threads
+ * touching different submaps never contend. insert(), find() and erase()
+ * may be called concurrently from any number of threads. load() and clear()
+ * must not overlap other calls.
+ *
+ * @tparam SubmapBits log2 of the number of submaps (locks)
+ */
+template<typename KeyType, typename ValueType, size_t SubmapBits = 5>
+class ConcurrentHashIndex : public IndexInterface<KeyType, ValueType> {
+private:
+    using Map = phmap::parallel_flat_hash_map<
+        KeyType, ValueType, phmap::Hash<KeyType>, phmap::EqualTo<KeyType>,
+        std::allocator<std::pair<const KeyType, ValueType>>, SubmapBits, std::shared_mutex>;
+
+    Map map_;
+
+public:
+    ConcurrentHashIndex() = default;
+
+    bool insert(const KeyType& key, const ValueType& value) override {
+        // Existing keys keep their value; the callback runs under the submap lock
+        return map_.try_emplace_l(key, [](auto&) {}, value);
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const override {
+        std::optional<ValueType> result;
+        map_.if_contains(key, [&result](const auto& kv) { result = kv.second; });
+        return result;
+    }
+
+    bool erase(const KeyType& key) override {
+        return map_.erase(key) > 0;
+    }
+
+    void load(const std::vector<KeyType>& keys,
+              const std::vector<ValueType>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values size mismatch");
+        }
+
+        map_.clear();
+        map_.reserve(keys.size());
+
+        // Later duplicates overwrite earlier ones, as in HashIndex
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const ValueType& value = values[i];
+            map_.try_emplace_l(keys[i], [&value](auto& kv) { kv.second = value; }, value);
+        }
+    }
+
+    size_t size() const override {
+        return map_.size();
+    }
+
+    size_t memory_footprint() const override {
+        // Submaps and their locks
+        size_t base_overhead = sizeof(map_);
+
+        // Each slot: key + value + one control byte, over the submaps' capacity
+        size_t slot_size = sizeof(KeyType) + sizeof(ValueType) + 1;
+        return base_overhead + map_.capacity() * slot_size;
+    }
+
+    std::string name() const override {
+        return "ConcurrentHashTable";
+    }
+
+    void clear() override {
+        map_.clear();
+    }
+
+    static constexpr size_t num_submaps() {
+        return size_t(1) << SubmapBits;
+    }
+};
+
+} // namespace hali
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "index_interface.h"
+#include "elias_fano_array.h"
+#include <pgm/pgm_index.hpp>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace hali {
+
+/**
+ * @brief Read-only PGM-Index over Elias-Fano compressed keys
+ *
+ * Same PGM model as PGMIndex, but the sorted keys are stored in an
+ * EliasFanoArray (about log2(range / n) + 2 bits per key) and dropped in
+ * plain form after the model is built. A lookup takes the PGM window's lo
+ * as the starting point of EliasFanoArray::lower_bound(), which jumps to
+ * the key's high-bits bucket and compares low bits only there.
+ *
+ * For the memory-bound read-only tier: insert() and erase() return false.
+ *
+ * @tparam Epsilon PGM error bound; smaller = narrower last-mile search, more segments
+ */
+template<typename KeyType, typename ValueType, size_t Epsilon = 64>
+class EliasFanoPGMIndex : public IndexInterface<KeyType, ValueType> {
+private:
+    static_assert(std::is_integral<KeyType>::value,
+                  "EliasFanoPGMIndex requires integral key type");
+
+    pgm::PGMIndex<KeyType, Epsilon> pgm_;
+    EliasFanoArray<KeyType> keys_;
+    std::vector<ValueType> values_;
+
+public:
+    EliasFanoPGMIndex() = default;
+
+    bool insert(const KeyType&, const ValueType&) override {
+        return false;  // Read-only
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const override {
+        if (keys_.empty()) return std::nullopt;
+
+        auto range = pgm_.search(key);
+        size_t pos = keys_.lower_bound(range.lo, key);
+        if (pos < keys_.size() && keys_.get(pos) == key) {
+            return values_[pos];
+        }
+        return std::nullopt;
+    }
+
+    bool erase(const KeyType&) override {
+        return false;  // Read-only
+    }
+
+    void load(const std::vector<KeyType>& keys,
+              const std::vector<ValueType>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values size mismatch");
+        }
+
+        // Sort by keys
+        std::vector<size_t> indices(keys.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::sort(indices.begin(), indices.end(),
+                  [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+        std::vector<KeyType> sorted_keys(keys.size());
+        values_.resize(values.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            sorted_keys[i] = keys[indices[i]];
+            values_[i] = values[indices[i]];
+        }
+
+        // Build PGM index, then keep the keys only in compressed form
+        pgm_ = sorted_keys.empty() ? pgm::PGMIndex<KeyType, Epsilon>()
+                                   : pgm::PGMIndex<KeyType, Epsilon>(sorted_keys.begin(), sorted_keys.end());
+        keys_ = EliasFanoArray<KeyType>(sorted_keys);
+    }
+
+    size_t size() const override {
+        return keys_.size();
+    }
+
+    size_t memory_footprint() const override {
+        return keys_.memory_footprint() +
+               values_.capacity() * sizeof(ValueType) +
+               pgm_.size_in_bytes();
+    }
+
+    std::string name() const override {
+        if (Epsilon == 64) {
+            return "PGM-Index(EF)";
+        }
+        return "PGM-Index(EF,eps=" + std::to_string(Epsilon) + ")";
+    }
+
+    void clear() override {
+        keys_ = EliasFanoArray<KeyType>();
+        values_.clear();
+        pgm_ = pgm::PGMIndex<KeyType, Epsilon>();
+    }
+
+    /**
+     * @brief Bytes of the compressed keys alone (model and values excluded)
+     */
+    size_t key_bytes() const {
+        return keys_.memory_footprint();
+    }
+};
+
+} // namespace hali
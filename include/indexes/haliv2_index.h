@@ -3,17 +3,134 @@
 #include "index_interface.h"
 #include "indexes/pgm_index.h"
 #include "bloom_filter.h"
+#include "search_utils.h"
+#include "arena_allocator.h"
+#include "write_ahead_log.h"
+#include "hot_key_cache.h"
+#include "spill_file.h"
+#include "for_block_array.h"
 #include <pgm/pgm_index.hpp>
 #include <art/map.h>
+#include "static_art.h"
 #include <parallel_hashmap/phmap.h>
 #include <vector>
 #include <memory>
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <limits>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace hali {
 
+/**
+ * @brief Expert model kinds HALIv2 can place in a key range
+ */
+enum class HALIExpertType {
+    PGM,    // Piecewise Geometric Model
+    RMI,    // Recursive Model Index
+    ART     // Adaptive Radix Tree
+};
+
+/**
+ * @brief Delta-buffer policy: hash map (fastest point operations)
+ */
+struct HashDeltaBuffer {
+    template<typename K, typename V>
+    using map_type = phmap::flat_hash_map<K, V>;
+    static constexpr double OVERHEAD = 1.3;  // Hash table slack
+};
+
+/**
+ * @brief Delta-buffer policy: adaptive radix tree (compact, ordered)
+ */
+struct ARTDeltaBuffer {
+    template<typename K, typename V>
+    using map_type = art::map<K, V>;
+    static constexpr double OVERHEAD = 1.25;  // Inner nodes
+};
+
+/**
+ * @brief Filter that keeps nothing and answers "maybe" to every query
+ */
+template<typename Allocator = std::allocator<uint64_t>>
+class NullFilter {
+public:
+    NullFilter(size_t = 0, size_t = 0, const Allocator& = Allocator()) {}
+
+    template<typename KeyType>
+    void insert(const KeyType&) {}
+
+    template<typename KeyType>
+    bool contains(const KeyType&) const { return true; }
+
+    size_t memory_footprint() const { return 0; }
+};
+
+/**
+ * @brief Filter policy: Bloom filters at the global and per-expert level
+ */
+struct BloomFilterPolicy {
+    template<typename Allocator>
+    using filter_type = BasicBloomFilter<Allocator>;
+    static constexpr bool ENABLED = true;
+};
+
+/**
+ * @brief Filter policy: no negative-lookup filters (saves their memory and hashing)
+ */
+struct NoFilterPolicy {
+    template<typename Allocator>
+    using filter_type = NullFilter<Allocator>;
+    static constexpr bool ENABLED = false;
+};
+
+/**
+ * @brief Expert-set policy: RMI and ART only (fast but more memory)
+ */
+struct SpeedExperts {
+    static constexpr bool USE_PGM = false;
+    static constexpr const char* NAME = "speed";
+
+    static HALIExpertType select(double linearity) {
+        return linearity > 0.90 ? HALIExpertType::RMI : HALIExpertType::ART;
+    }
+};
+
+/**
+ * @brief Expert-set policy: PGM, RMI and ART by linearity (original heuristic)
+ */
+struct BalancedExperts {
+    static constexpr bool USE_PGM = true;
+    static constexpr const char* NAME = "balanced";
+
+    static HALIExpertType select(double linearity) {
+        if (linearity > 0.95) {
+            return HALIExpertType::PGM;
+        } else if (linearity > 0.80) {
+            return HALIExpertType::RMI;
+        } else {
+            return HALIExpertType::ART;
+        }
+    }
+};
+
+/**
+ * @brief Expert-set policy: PGM and RMI only (compact)
+ *
+ * ART is still used for partitions too small to learn and for empty ranges.
+ */
+struct MemoryExperts {
+    static constexpr bool USE_PGM = true;
+    static constexpr const char* NAME = "memory";
+
+    static HALIExpertType select(double linearity) {
+        return linearity > 0.70 ? HALIExpertType::PGM : HALIExpertType::RMI;
+    }
+};
+
 /**
  * @brief HALIv2 - Hierarchical Adaptive Learned Index (Version 2)
  *
@@ -27,9 +144,24 @@ namespace hali {
  * Three-level architecture:
  * Level 1: Binary Search Router over disjoint key ranges
  * Level 2: Adaptive Expert Models (PGM/RMI/ART based on linearity + compression level)
- * Level 3: Delta-Buffer for dynamic updates (ART or HashMap based on compression level)
+ * Level 3: LSM-style write path: a small memtable (ART or HashMap, per
+ *          DeltaBufferPolicy) flushed into immutable sorted runs that compact
+ *          level by level and are merged into the experts once they exceed
+ *          merge_threshold, both in bounded slices
+ *
+ * Structural choices are compile-time policies, so every preset (HALIv2Speed,
+ * HALIv2Balanced, HALIv2Memory) gets a hot path with no per-operation branching
+ * and no members it does not use. The runtime compression level still tunes
+ * expert count, Bloom bits per key and PGM epsilon.
+ *
+ * @tparam DeltaBufferPolicy HashDeltaBuffer or ARTDeltaBuffer
+ * @tparam FilterPolicy BloomFilterPolicy or NoFilterPolicy
+ * @tparam ExpertPolicy SpeedExperts, BalancedExperts or MemoryExperts
  */
-template<typename KeyType, typename ValueType>
+template<typename KeyType, typename ValueType,
+         typename DeltaBufferPolicy = ARTDeltaBuffer,
+         typename FilterPolicy = BloomFilterPolicy,
+         typename ExpertPolicy = BalancedExperts>
 class HALIv2Index : public IndexInterface<KeyType, ValueType> {
 private:
     static_assert(std::is_integral<KeyType>::value,
@@ -41,6 +173,8 @@ private:
     struct Config {
         double compression_level = 0.5;  // 0.0 = speed, 1.0 = memory
         double merge_threshold = 0.01;   // Merge when buffer exceeds 1% of main index
+        bool use_arena = false;          // Lay out expert arrays/filters on huge-page arena
+        bool lazy_build = false;         // load() defers expert models/filters to first access
 
         size_t adaptive_expert_count(size_t n) const {
             // Base: sqrt(n) / 100 for balance
@@ -53,11 +187,6 @@ private:
             return std::max(size_t(4), static_cast<size_t>(base * scale));
         }
 
-        bool use_bloom_filters() const {
-            // Enabled with fallback safety check in find()
-            return true;
-        }
-
         size_t bloom_bits_per_key() const {
             // More bits for read-heavy workloads (lower FPR)
             // compression_level closer to 0 = speed = fewer bloom bits (faster hashing)
@@ -68,14 +197,12 @@ private:
 
     Config config_;
 
-    /**
-     * @brief Expert type selection
-     */
-    enum class ExpertType {
-        PGM,    // Piecewise Geometric Model
-        RMI,    // Recursive Model Index
-        ART     // Adaptive Radix Tree
-    };
+    using ExpertType = HALIExpertType;
+
+    using KeyArray = std::vector<KeyType, ArenaAllocator<KeyType>>;
+    using ValueArray = std::vector<ValueType, ArenaAllocator<ValueType>>;
+    using ExpertBloom = typename FilterPolicy::template filter_type<ArenaAllocator<uint64_t>>;
+    using DeltaMap = typename DeltaBufferPolicy::template map_type<KeyType, ValueType>;
 
     /**
      * @brief Expert with guaranteed key range
@@ -84,33 +211,72 @@ private:
         ExpertType type;
         KeyType min_key;  // Inclusive lower bound
         KeyType max_key;  // Inclusive upper bound
-        std::vector<KeyType> keys;
-        std::vector<ValueType> values;
+        KeyArray keys;
+        ValueArray values;
+
+        // Tiered storage (see enable_tiering()): an evicted expert's arrays are
+        // dropped from memory and live only in the spill file, values after keys
+        bool evicted = false;
+        bool spilled = false;       // Arrays already written to the spill file
+        uint64_t spill_offset = 0;
+        size_t spilled_keys = 0;
+        uint64_t last_access = 0;   // access_clock_ at the latest lookup
+        size_t cold_bytes_read = 0; // Read from the spill file or decoded since going cold
+
+        // Cold compression (see enable_cold_compression()): a compressed
+        // expert's arrays are replaced by FOR-bitpacked blocks
+        bool compressed = false;
+        FORBlockArray<KeyType> packed_keys;
+        FORBlockArray<ValueType> packed_values;
 
         virtual ~Expert() = default;
         virtual std::optional<ValueType> find(KeyType key) const = 0;
         virtual size_t memory_footprint() const = 0;
 
+        // Positions [lo, hi) of n keys that must hold key if present, from the model alone
+        virtual std::pair<size_t, size_t> search_window(KeyType key, size_t n) const {
+            (void)key;
+            return {0, n};
+        }
+
         // Check if key falls in this expert's range
         bool owns_key(KeyType key) const {
             return key >= min_key && key <= max_key;
         }
+
+        size_t data_bytes() const {
+            return keys.size() * (sizeof(KeyType) + sizeof(ValueType));
+        }
+
+        size_t packed_bytes() const {
+            return packed_keys.memory_footprint() + packed_values.memory_footprint();
+        }
+
+        // Copy partition data into storage (arena-backed when arena != nullptr)
+        void assign_data(const std::vector<KeyType>& k, const std::vector<ValueType>& v,
+                         Arena* arena) {
+            keys = KeyArray(k.begin(), k.end(), ArenaAllocator<KeyType>(arena));
+            values = ValueArray(v.begin(), v.end(), ArenaAllocator<ValueType>(arena));
+        }
     };
 
     /**
      * @brief PGM Expert
+     *
+     * Epsilon is a compile-time parameter of pgm::PGMIndex, so each supported
+     * error bound gets its own instantiation (see make_pgm_expert()).
      */
+    template<size_t Epsilon>
     struct PGMExpert : public Expert {
-        pgm::PGMIndex<KeyType, 64> pgm;
+        pgm::PGMIndex<KeyType, Epsilon> pgm;
 
         PGMExpert(const std::vector<KeyType>& k, const std::vector<ValueType>& v,
-                  KeyType min_k, KeyType max_k) {
+                  KeyType min_k, KeyType max_k, Arena* arena) {
             this->type = ExpertType::PGM;
-            this->keys = k;
-            this->values = v;
+            this->assign_data(k, v, arena);
             this->min_key = min_k;
             this->max_key = max_k;
-            pgm = pgm::PGMIndex<KeyType, 64>(k.begin(), k.end());
+            pgm = pgm::PGMIndex<KeyType, Epsilon>(k.begin(), k.end());
         }
 
         std::optional<ValueType> find(KeyType key) const override {
@@ -128,9 +294,14 @@ private:
             return std::nullopt;
         }
 
+        std::pair<size_t, size_t> search_window(KeyType key, size_t n) const override {
+            auto range = pgm.search(key);
+            return {range.lo, std::min(range.hi, n)};
+        }
+
         size_t memory_footprint() const override {
             return this->keys.size() * (sizeof(KeyType) + sizeof(ValueType)) +
-                   (this->keys.size() / 5000) * 20;
+                   pgm.size_in_bytes();
         }
     };
 
@@ -139,22 +310,35 @@ private:
      */
     struct RMIExpert : public Expert {
         struct LinearModel {
+            // Least-squares sums, so a model can be trained in slices
+            struct Sums {
+                size_t n = 0;
+                double x = 0, y = 0, xy = 0, x2 = 0;
+
+                void add(KeyType key, size_t pos) {
+                    double kx = static_cast<double>(key);
+                    double py = static_cast<double>(pos);
+                    n++; x += kx; y += py; xy += kx * py; x2 += kx * kx;
+                }
+            };
+
             double slope = 0.0, intercept = 0.0;
+            int64_t min_error = 0, max_error = 0;  // Measured (true - predicted)
 
             void train(const std::vector<KeyType>& keys, const std::vector<size_t>& positions) {
-                if (keys.empty()) return;
-                size_t n = keys.size();
-                double sum_x = 0, sum_y = 0, sum_xy = 0, sum_x2 = 0;
-
-                for (size_t i = 0; i < n; ++i) {
-                    double x = static_cast<double>(keys[i]);
-                    double y = static_cast<double>(positions[i]);
-                    sum_x += x; sum_y += y; sum_xy += x * y; sum_x2 += x * x;
+                Sums sums;
+                for (size_t i = 0; i < keys.size(); ++i) {
+                    sums.add(keys[i], positions[i]);
                 }
+                fit(sums);
+            }
 
-                double mean_x = sum_x / n, mean_y = sum_y / n;
-                double num = sum_xy - n * mean_x * mean_y;
-                double den = sum_x2 - n * mean_x * mean_x;
+            void fit(const Sums& sums) {
+                if (sums.n == 0) return;
+                size_t n = sums.n;
+                double mean_x = sums.x / n, mean_y = sums.y / n;
+                double num = sums.xy - n * mean_x * mean_y;
+                double den = sums.x2 - n * mean_x * mean_x;
 
                 if (std::abs(den) > 1e-10) {
                     slope = num / den;
@@ -169,42 +353,69 @@ private:
                 double pred = slope * static_cast<double>(key) + intercept;
                 return static_cast<size_t>(std::max(0.0, std::min(pred, static_cast<double>(max_pos))));
             }
+
+            void record_errors(const std::vector<KeyType>& keys, size_t max_pos) {
+                min_error = 0;
+                max_error = 0;
+                extend_errors(keys, max_pos, 0, keys.size());
+            }
+
+            // Widen the error bounds to cover keys[begin, end)
+            void extend_errors(const std::vector<KeyType>& keys, size_t max_pos,
+                               size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    int64_t err = static_cast<int64_t>(i) -
+                                  static_cast<int64_t>(predict(keys[i], max_pos));
+                    min_error = std::min(min_error, err);
+                    max_error = std::max(max_error, err);
+                }
+            }
         };
 
         LinearModel model;
-        static constexpr size_t ERROR = 64;
+
+        // Wider measured windows use exponential search from the prediction
+        static constexpr int64_t MAX_BOUNDED_WINDOW = 4096;
 
         RMIExpert(const std::vector<KeyType>& k, const std::vector<ValueType>& v,
-                  KeyType min_k, KeyType max_k) {
+                  KeyType min_k, KeyType max_k, Arena* arena) {
             this->type = ExpertType::RMI;
-            this->keys = k;
-            this->values = v;
+            this->assign_data(k, v, arena);
             this->min_key = min_k;
             this->max_key = max_k;
 
             std::vector<size_t> positions(k.size());
             std::iota(positions.begin(), positions.end(), 0);
             model.train(k, positions);
+            model.record_errors(k, k.size() - 1);
         }
 
         std::optional<ValueType> find(KeyType key) const override {
             // Binary search routing guarantees correct expert, so no need for owns_key() check
 
             size_t pos = model.predict(key, this->keys.size() - 1);
-            size_t start = (pos > ERROR) ? pos - ERROR : 0;
-            size_t end = std::min(pos + ERROR, this->keys.size());
+            auto it = (model.max_error - model.min_error > MAX_BOUNDED_WINDOW) ?
+                SearchUtils::exponential_search(this->keys, key, pos) :
+                SearchUtils::bounded_search(this->keys, key, pos,
+                                            model.min_error, model.max_error);
 
-            auto it = std::lower_bound(this->keys.begin() + start,
-                                      this->keys.begin() + end,
-                                      key);
-
-            if (it != this->keys.begin() + end && *it == key) {
+            if (it != this->keys.end() && *it == key) {
                 size_t idx = std::distance(this->keys.begin(), it);
                 return this->values[idx];
             }
             return std::nullopt;
         }
 
+        std::pair<size_t, size_t> search_window(KeyType key, size_t n) const override {
+            if (n == 0 || model.max_error - model.min_error > MAX_BOUNDED_WINDOW) {
+                return {0, n};
+            }
+            int64_t pos = static_cast<int64_t>(model.predict(key, n - 1));
+            int64_t lo = std::max<int64_t>(0, pos + model.min_error);
+            int64_t hi = std::min<int64_t>(static_cast<int64_t>(n), pos + model.max_error + 1);
+            return {static_cast<size_t>(lo), static_cast<size_t>(std::max(lo, hi))};
+        }
+
         size_t memory_footprint() const override {
             return this->keys.size() * (sizeof(KeyType) + sizeof(ValueType)) +
                    sizeof(LinearModel);
@@ -215,134 +426,470 @@ private:
      * @brief ART Expert
      */
     struct ARTExpert : public Expert {
-        art::map<KeyType, ValueType> tree;
+        // Built bottom-up over the expert's own sorted arrays (leaves are positions)
+        StaticART<KeyType> tree;
 
         ARTExpert(const std::vector<KeyType>& k, const std::vector<ValueType>& v,
-                  KeyType min_k, KeyType max_k) {
+                  KeyType min_k, KeyType max_k, Arena* arena) {
             this->type = ExpertType::ART;
-            this->keys = k;
-            this->values = v;
+            this->assign_data(k, v, arena);
             this->min_key = min_k;
             this->max_key = max_k;
 
-            for (size_t i = 0; i < k.size(); ++i) {
-                tree[k[i]] = v[i];
-            }
+            tree = StaticART<KeyType>(this->keys.data(), this->keys.size());
         }
 
         std::optional<ValueType> find(KeyType key) const override {
             // Binary search routing guarantees correct expert, so no need for owns_key() check
 
-            auto it = tree.find(key);
-            if (it != tree.end()) {
-                return it->second;
+            size_t pos = tree.find(key, this->keys.data());
+            if (pos != StaticART<KeyType>::NOT_FOUND) {
+                return this->values[pos];
             }
             return std::nullopt;
         }
 
         size_t memory_footprint() const override {
-            return this->keys.size() * (sizeof(KeyType) + sizeof(ValueType)) * 1.25;
+            return this->keys.size() * (sizeof(KeyType) + sizeof(ValueType)) +
+                   tree.memory_footprint();
+        }
+
+        // The tree holds positions only, so it narrows the window to one slot
+        // without the arrays, and stays valid while they are spilled or packed
+        std::pair<size_t, size_t> search_window(KeyType key, size_t n) const override {
+            size_t pos = tree.candidate(key);
+            if (pos == StaticART<KeyType>::NOT_FOUND || pos >= n) {
+                return {0, 0};
+            }
+            return {pos, pos + 1};
+        }
+    };
+
+    /**
+     * @brief Append-only tail for in-order keys beyond the indexed range
+     *
+     * Monotonically increasing inserts (timestamps, sequence numbers) are
+     * appended to a sorted array and covered by a streaming piecewise-linear
+     * model (shrinking cone, FITing-tree style): each point narrows the current
+     * segment's feasible slope range, and a new segment starts only when the
+     * range becomes empty. Appends are O(1) amortized and every key stays within
+     * EPSILON (+ erased) positions of its prediction.
+     */
+    struct TailExpert {
+        struct Segment {
+            KeyType first_key;
+            size_t first_pos;
+            double slope_lo;
+            double slope_hi;
+
+            double slope() const {
+                return std::isinf(slope_hi) ? slope_lo : (slope_lo + slope_hi) / 2;
+            }
+        };
+
+        static constexpr int64_t EPSILON = 16;
+
+        std::vector<KeyType> keys;
+        std::vector<ValueType> values;
+        std::vector<Segment> segments;
+        size_t erased = 0;  // Erases since the last seal; each can shift positions by one
+
+        bool empty() const { return keys.empty(); }
+        size_t size() const { return keys.size(); }
+
+        // True if key can be appended without breaking sorted order
+        bool accepts(KeyType key) const {
+            return keys.empty() || key > keys.back();
+        }
+
+        void append(KeyType key, ValueType value) {
+            size_t pos = keys.size();
+            keys.push_back(key);
+            values.push_back(value);
+
+            if (!segments.empty()) {
+                Segment& seg = segments.back();
+                double dx = static_cast<double>(key - seg.first_key);
+                double dy = static_cast<double>(pos - seg.first_pos);
+                double lo = (dy - EPSILON) / dx;
+                double hi = (dy + EPSILON) / dx;
+                if (lo <= seg.slope_hi && hi >= seg.slope_lo) {
+                    // Point fits the cone: shrink it
+                    seg.slope_lo = std::max(seg.slope_lo, lo);
+                    seg.slope_hi = std::min(seg.slope_hi, hi);
+                    return;
+                }
+            }
+            segments.push_back({key, pos, 0.0, std::numeric_limits<double>::infinity()});
+        }
+
+        std::optional<ValueType> find(KeyType key) const {
+            if (keys.empty() || key < keys.front() || key > keys.back()) {
+                return std::nullopt;
+            }
+
+            auto seg_it = std::upper_bound(segments.begin(), segments.end(), key,
+                [](KeyType k, const Segment& seg) { return k < seg.first_key; });
+            const Segment& seg = *(seg_it - 1);
+
+            double pred = seg.first_pos + seg.slope() * static_cast<double>(key - seg.first_key);
+            size_t pos = static_cast<size_t>(std::max(0.0, pred));
+            int64_t slack = EPSILON + 1 + static_cast<int64_t>(erased);
+            auto it = SearchUtils::bounded_search(keys, key, pos, -slack, EPSILON + 1);
+
+            if (it != keys.end() && *it == key) {
+                return values[std::distance(keys.begin(), it)];
+            }
+            return std::nullopt;
+        }
+
+        bool erase(KeyType key) {
+            auto it = std::lower_bound(keys.begin(), keys.end(), key);
+            if (it == keys.end() || *it != key) {
+                return false;
+            }
+            size_t pos = std::distance(keys.begin(), it);
+            keys.erase(it);
+            values.erase(values.begin() + pos);
+            if (keys.empty()) {
+                // No origin left for the next append to extend
+                clear();
+                return true;
+            }
+
+            // Later segments keep exact origins; the containing one absorbs the shift
+            for (auto& seg : segments) {
+                if (seg.first_pos > pos) {
+                    seg.first_pos--;
+                }
+            }
+            erased++;
+            return true;
+        }
+
+        void clear() {
+            keys.clear();
+            values.clear();
+            segments.clear();
+            erased = 0;
+        }
+
+        size_t memory_footprint() const {
+            return keys.capacity() * sizeof(KeyType) + values.capacity() * sizeof(ValueType) +
+                   segments.capacity() * sizeof(Segment);
+        }
+    };
+
+    /**
+     * @brief Immutable sorted run flushed from the memtable
+     *
+     * Located by RMIExpert's linear model with measured error bounds and
+     * guarded by its own filter, so a negative lookup usually costs one
+     * filter probe per run. Erased entries are marked dead in place and
+     * dropped when the run is compacted or merged.
+     */
+    struct SortedRun {
+        using Model = typename RMIExpert::LinearModel;
+
+        std::vector<KeyType> keys;
+        std::vector<ValueType> values;
+        std::vector<bool> dead;
+        size_t num_dead = 0;
+        Model model;
+        ExpertBloom filter;
+
+        SortedRun(std::vector<KeyType> k, std::vector<ValueType> v, size_t bits_per_key)
+            : keys(std::move(k)), values(std::move(v)), dead(keys.size(), false),
+              filter(std::max(size_t(1), keys.size()), bits_per_key) {
+            std::vector<size_t> positions(keys.size());
+            std::iota(positions.begin(), positions.end(), 0);
+            model.train(keys, positions);
+            model.record_errors(keys, keys.size() - 1);
+            for (const auto& key : keys) {
+                filter.insert(key);
+            }
+        }
+
+        // Model and filter already built over k (see compaction_step())
+        SortedRun(std::vector<KeyType> k, std::vector<ValueType> v, const Model& m, ExpertBloom f)
+            : keys(std::move(k)), values(std::move(v)), dead(keys.size(), false),
+              model(m), filter(std::move(f)) {}
+
+        size_t live() const { return keys.size() - num_dead; }
+
+        // Position of a live key, or keys.size() if absent
+        size_t locate(KeyType key) const {
+            if (keys.empty() || key < keys.front() || key > keys.back() ||
+                !filter.contains(key)) {
+                return keys.size();
+            }
+
+            size_t pos = model.predict(key, keys.size() - 1);
+            auto it = (model.max_error - model.min_error > RMIExpert::MAX_BOUNDED_WINDOW) ?
+                SearchUtils::exponential_search(keys, key, pos) :
+                SearchUtils::bounded_search(keys, key, pos, model.min_error, model.max_error);
+
+            if (it != keys.end() && *it == key) {
+                size_t idx = std::distance(keys.begin(), it);
+                if (!dead[idx]) {
+                    return idx;
+                }
+            }
+            return keys.size();
+        }
+
+        std::optional<ValueType> find(KeyType key) const {
+            size_t idx = locate(key);
+            if (idx == keys.size()) {
+                return std::nullopt;
+            }
+            return values[idx];
+        }
+
+        bool erase(KeyType key) {
+            size_t idx = locate(key);
+            if (idx == keys.size()) {
+                return false;
+            }
+            dead[idx] = true;
+            num_dead++;
+            return true;
+        }
+
+        size_t memory_footprint() const {
+            return keys.capacity() * sizeof(KeyType) + values.capacity() * sizeof(ValueType) +
+                   dead.capacity() / 8 + sizeof(Model) + filter.memory_footprint();
         }
     };
 
+    // Backing store for expert arrays and filter bits; declared before its
+    // users so it is destroyed after them
+    Arena arena_;
+
     // Level 1: Router with guaranteed disjoint key ranges
     std::vector<std::unique_ptr<Expert>> experts_;
     std::vector<KeyType> expert_boundaries_;  // Sorted boundaries for binary search
 
     // Level 2: Bloom filters for fast negative lookups
-    BloomFilter global_bloom_;                      // Global filter for all keys
-    std::vector<BloomFilter> expert_blooms_;        // Per-expert filters
+    ExpertBloom global_bloom_;                      // Global filter for all keys
+    std::vector<ExpertBloom> expert_blooms_;        // Per-expert filters
+
+    // Level 3: Memtable, flushed into level-0 runs at MEMTABLE_KEYS
+    DeltaMap delta_buffer_;
+
+    // Sorted runs by level (level 0 = freshest); a level holding more than
+    // LEVEL_FANOUT runs is compacted into one run of the next level
+    std::vector<std::vector<SortedRun>> levels_;
+    size_t run_keys_ = 0;  // Live keys across levels_
+    static constexpr size_t MEMTABLE_KEYS = 4096;
+    static constexpr size_t LEVEL_FANOUT = 4;
+
+    /**
+     * @brief Progress of an incremental level compaction (see compaction_step())
+     */
+    struct Compaction {
+        size_t level;                    // levels_[level][0, inputs) are being merged
+        size_t inputs;
+        std::vector<size_t> cursors;     // Next entry of each input run
+        std::vector<KeyType> keys;       // Output so far
+        std::vector<ValueType> values;
+        typename SortedRun::Model::Sums sums;
+        typename SortedRun::Model model;
+        ExpertBloom filter;
+        bool merged = false;             // Output complete; recording model errors
+        size_t error_pos = 0;            // Output entries whose error is recorded
+        phmap::flat_hash_set<KeyType> erased;  // Input keys erased after being copied
+    };
+    std::unique_ptr<Compaction> compaction_;
+    static constexpr size_t COMPACTION_SLICE_KEYS = 1024;  // Entries per compaction slice
+
+    // Append-only tail for keys past the last expert (sealed into experts_ when full)
+    TailExpert tail_;
+    size_t tail_capacity_ = MIN_TAIL_CAPACITY;
+    static constexpr size_t MIN_TAIL_CAPACITY = 4096;
+
+    /**
+     * @brief Progress of an incremental delta-buffer merge (see merge_step())
+     */
+    enum class MergePhase {
+        IDLE,     // No merge in progress
+        COLLECT,  // Routing merging run entries into per-expert buckets
+        REBUILD   // Rebuilding one expert per slice
+    };
 
-    // Level 3: Delta buffer
-    art::map<KeyType, ValueType> delta_buffer_art_;      // For compression_level >= 0.5
-    phmap::flat_hash_map<KeyType, ValueType> delta_buffer_hash_;  // For compression_level < 0.5
+    static constexpr size_t MERGE_SLICE_KEYS = 1024;  // Run entries routed per COLLECT slice
+    static constexpr size_t MIN_MERGE_KEYS = 1024;    // Fewer run keys are never merged
+    static constexpr size_t MERGE_EXPERT_KEYS = 8192; // Rebuilt experts are split to about this size
+
+    // Runs being merged into the experts; stay readable until the merge completes
+    MergePhase merge_phase_ = MergePhase::IDLE;
+    std::vector<SortedRun> merging_runs_;
+    size_t merging_keys_ = 0;                     // Live keys across merging_runs_
+    size_t collect_run_ = 0;                      // COLLECT position: run ...
+    size_t collect_pos_ = 0;                      // ... and entry within it
+    std::vector<std::vector<std::pair<KeyType, ValueType>>> merge_buckets_;  // One per expert
+    size_t merge_cursor_ = 0;                     // Next expert to rebuild
+    phmap::flat_hash_set<KeyType> merge_erased_;  // Merging keys erased after COLLECT saw them
+    size_t merges_completed_ = 0;
+
+    // Expert keys erased since their expert was last built; find() skips
+    // them and rebuild_expert() drops them
+    phmap::flat_hash_set<KeyType> expert_erased_;
+
+    // Keys >= this are not in global_bloom_ (appended after load)
+    KeyType global_bloom_end_ = KeyType();
 
     size_t total_size_ = 0;
 
+    // Optional durability for delta-buffer updates (see open_wal())
+    using WAL = WriteAheadLog<KeyType, ValueType>;
+    std::unique_ptr<WAL> wal_;
+
+    // Optional cache of hot positive lookups, probed before the write path
+    // (see enable_hot_cache()); find() fills it, so it is not const
+    using HotCache = HotKeyCache<KeyType, ValueType>;
+    std::unique_ptr<HotCache> hot_cache_;
+
+    /**
+     * @brief Cold-expert tiering state (see enable_tiering())
+     */
+    struct Tiering {
+        SpillFile file;
+        size_t memory_budget;  // Bytes of resident expert arrays
+        size_t faults = 0;
+        size_t evictions = 0;
+
+        Tiering(const std::string& path, size_t budget) : file(path), memory_budget(budget) {}
+    };
+    std::unique_ptr<Tiering> tiering_;
+
+    /**
+     * @brief Cold-expert compression state (see enable_cold_compression())
+     */
+    struct ColdCompression {
+        uint64_t idle_lookups;    // Experts idle for this many expert lookups are compressed
+        uint64_t next_sweep;      // access_clock_ value of the next automatic sweep
+        size_t sweep_cursor = std::numeric_limits<size_t>::max();  // Next expert of the running sweep
+        size_t compressions = 0;
+        size_t inflations = 0;
+        size_t blocks_decoded = 0;
+    };
+    std::unique_ptr<ColdCompression> compression_;
+    static constexpr size_t COLD_SWEEP_SCAN = 64;  // Experts an automatic sweep checks per lookup
+
+    // Advances on every lookup that reaches an expert while tiering or cold
+    // compression is on; orders experts by recency
+    mutable uint64_t access_clock_ = 0;
+
+    /**
+     * @brief Partition of a lazily built expert (see set_lazy_build())
+     *
+     * experts_[i] stays null until the slot's once_flag has run; built is
+     * set (release) after the expert and its filter are in place, so code
+     * that may run beside the warmer can test it instead of the pointer.
+     */
+    struct LazySlot {
+        std::once_flag once;
+        std::atomic<bool> built{false};
+        std::vector<KeyType> keys;
+        std::vector<ValueType> values;
+        size_t avg_expert_keys = 0;
+    };
+    std::vector<std::unique_ptr<LazySlot>> lazy_slots_;  // Parallel to experts_; empty when eager
+    static constexpr size_t LAZY_EXPERT_KEYS = 65536;     // Lazy partitions are split to about this size
+
+    /**
+     * @brief Background thread building pending experts in router order
+     */
+    struct Warmer {
+        std::thread thread;
+        std::atomic<bool> stop{false};
+    };
+    std::unique_ptr<Warmer> warmer_;
+
 public:
-    HALIv2Index(double compression_level = 0.5, double merge_threshold = 0.01) {
+    HALIv2Index(double compression_level = 0.5, double merge_threshold = 0.01,
+                bool use_arena = false) {
         config_.compression_level = compression_level;
         config_.merge_threshold = merge_threshold;
+        config_.use_arena = use_arena;
+    }
+
+    ~HALIv2Index() override {
+        stop_warmer();
     }
 
     bool insert(const KeyType& key, const ValueType& value) override {
-        // Check if key already exists
-        if (find(key).has_value()) {
+        if (!insert_unlogged(key, value)) {
             return false;
         }
-
-        // Insert into delta buffer
-        if (config_.compression_level < 0.5) {
-            auto result = delta_buffer_hash_.insert({key, value});
-            return result.second;
-        } else {
-            auto result = delta_buffer_art_.insert({key, value});
-            return result.second;
+        if (wal_) {
+            wal_->append(WAL::RecordType::INSERT, key, value);
         }
+        return true;
     }
 
     std::optional<ValueType> find(const KeyType& key) const override {
-        // Level 1: Check delta buffer first (bypass Bloom filter for delta)
-        if (config_.compression_level < 0.5) {
-            auto it = delta_buffer_hash_.find(key);
-            if (it != delta_buffer_hash_.end()) {
-                return it->second;
-            }
-        } else {
-            auto it = delta_buffer_art_.find(key);
-            if (it != delta_buffer_art_.end()) {
-                return it->second;
-            }
+        if (!hot_cache_) {
+            return find_uncached(key);
         }
 
-        // Level 2: Query main index
-        if (experts_.empty()) {
-            return std::nullopt;
+        // Level 0: Hot-key cache (positive results only)
+        if (const ValueType* cached = hot_cache_->lookup(key)) {
+            return *cached;
         }
-
-        // Level 3: Check global Bloom filter for fast negative lookup
-        // (Only check after delta buffer, since Bloom filter doesn't include delta keys)
-        if (config_.use_bloom_filters() && !global_bloom_.contains(key)) {
-            return std::nullopt;  // Definitely not in main index
+        auto result = find_uncached(key);
+        if (result.has_value()) {
+            hot_cache_->fill(key, *result);
         }
+        return result;
+    }
 
-        // Level 4: Binary search over expert boundaries to find correct expert
-        size_t expert_id = route_to_expert(key);
-
-        if (expert_id >= experts_.size()) {
-            return std::nullopt;
+    /**
+     * @brief find() without the hot-key cache (neither probed nor filled)
+     */
+    std::optional<ValueType> find_uncached(const KeyType& key) const {
+        // Level 1: Check delta buffer first (bypass Bloom filter for delta)
+        auto delta_it = delta_buffer_.find(key);
+        if (delta_it != delta_buffer_.end()) {
+            return delta_it->second;
         }
 
-        // Level 5: Check expert Bloom filter (RE-ENABLED with safety check)
-        if (config_.use_bloom_filters() && expert_id < expert_blooms_.size()) {
-            if (!expert_blooms_[expert_id].contains(key)) {
-                // Bloom filter says key is not in this expert
-                // But due to range-based partitioning, let's double-check the key is within bounds
-                if (expert_id < experts_.size()) {
-                    const auto& expert = experts_[expert_id];
-                    if (key < expert->min_key || key > expert->max_key) {
-                        // Key is definitely outside this expert's range
-                        return std::nullopt;
-                    }
-                    // Key might be in expert's range but Bloom filter gives false negative
-                    // This can happen with hash collisions - proceed to expert query
-                } else {
-                    return std::nullopt;
+        // Sorted runs (each skipped after one filter probe on a miss)
+        for (const auto& level : levels_) {
+            for (const auto& run : level) {
+                auto result = run.find(key);
+                if (result.has_value()) {
+                    return result;
                 }
             }
         }
 
-        // Level 6: Query expert
-        return experts_[expert_id]->find(key);
+        // Runs of an in-progress merge: authoritative until the merge
+        // completes, whether or not the key's expert has been rebuilt yet
+        for (const auto& run : merging_runs_) {
+            auto result = run.find(key);
+            if (result.has_value()) {
+                return result;
+            }
+        }
+
+        // Append-only tail (keys past the last expert)
+        if (!tail_.empty() && key >= tail_.keys.front()) {
+            return tail_.find(key);
+        }
+
+        return find_in_experts(key);
     }
 
     bool erase(const KeyType& key) override {
-        // Erase from delta buffer only (lazy deletion from main index)
-        if (config_.compression_level < 0.5) {
-            return delta_buffer_hash_.erase(key) > 0;
-        } else {
-            return delta_buffer_art_.erase(key) > 0;
+        if (!erase_unlogged(key)) {
+            return false;
+        }
+        if (wal_) {
+            wal_->append(WAL::RecordType::ERASE, key, ValueType());
         }
+        return true;
     }
 
     void load(const std::vector<KeyType>& keys,
@@ -351,6 +898,13 @@ public:
             throw std::invalid_argument("Keys and values size mismatch");
         }
 
+        // Drop previous experts/filters and bulk-release their arena memory
+        release_storage();
+        Arena* arena = storage_arena();
+        if (tiering_) {
+            tiering_->file.reset();
+        }
+
         total_size_ = keys.size();
 
         // Sort data by key
@@ -363,15 +917,15 @@ public:
         // Determine number of experts based on dataset size and compression level
         size_t num_experts = config_.adaptive_expert_count(keys.size());
 
-        experts_.clear();
         experts_.reserve(num_experts);
-        expert_boundaries_.clear();
         expert_boundaries_.reserve(num_experts + 1);
 
-        // Initialize global Bloom filter
-        global_bloom_ = BloomFilter(keys.size(), config_.bloom_bits_per_key());
+        // Initialize global Bloom filter (lazy loads skip it; see set_lazy_build())
+        if (!config_.lazy_build) {
+            global_bloom_ = ExpertBloom(keys.size(), config_.bloom_bits_per_key(),
+                                        ArenaAllocator<uint64_t>(arena));
+        }
 
-        expert_blooms_.clear();
         expert_blooms_.reserve(num_experts);
 
         // Partition by KEY RANGES (true range-based partitioning for clustered data)
@@ -399,7 +953,9 @@ public:
             expert_data[expert_id].push_back(kv);
 
             // Insert into global Bloom filter
-            global_bloom_.insert(key);
+            if (!config_.lazy_build) {
+                global_bloom_.insert(key);
+            }
         }
 
         // Create experts from partitioned data
@@ -418,8 +974,9 @@ public:
                 // Empty expert due to gaps in clustered data
                 // Create an empty ART expert as placeholder to maintain expert_id consistency
                 experts_.push_back(std::make_unique<ARTExpert>(
-                    std::vector<KeyType>(), std::vector<ValueType>(), expected_min, expected_max));
-                expert_blooms_.push_back(BloomFilter(1, config_.bloom_bits_per_key()));  // Empty Bloom filter
+                    std::vector<KeyType>(), std::vector<ValueType>(), expected_min, expected_max, arena));
+                expert_blooms_.push_back(ExpertBloom(1, config_.bloom_bits_per_key(),
+                                                     ArenaAllocator<uint64_t>(arena)));  // Empty Bloom filter
                 continue;
             }
 
@@ -431,51 +988,86 @@ public:
                 part_values.push_back(kv.second);
             }
 
-            // Determine expert type based on data characteristics and compression level
-            ExpertType type = select_expert_type(part_keys);
-
-            // Create expert with actual key range (for data storage)
-            KeyType min_key = part_keys.front();
-            KeyType max_key = part_keys.back();
+            if (config_.lazy_build) {
+                // Router slots only; ensure_built() trains each on first access.
+                // Large partitions are cut into pieces of about LAZY_EXPERT_KEYS
+                // so a first lookup never waits for a huge expert to train
+                size_t n = part_keys.size();
+                size_t parts = (n > 2 * LAZY_EXPERT_KEYS) ? (n + LAZY_EXPERT_KEYS - 1) / LAZY_EXPERT_KEYS : 1;
+                for (size_t p = 0; p < parts; ++p) {
+                    size_t begin = p * n / parts;
+                    size_t end = (p + 1) * n / parts;
+                    if (p > 0) {
+                        expert_boundaries_.push_back(part_keys[begin]);
+                    }
 
-            if (type == ExpertType::PGM) {
-                experts_.push_back(std::make_unique<PGMExpert>(part_keys, part_values, min_key, max_key));
-            } else if (type == ExpertType::RMI) {
-                experts_.push_back(std::make_unique<RMIExpert>(part_keys, part_values, min_key, max_key));
-            } else {
-                experts_.push_back(std::make_unique<ARTExpert>(part_keys, part_values, min_key, max_key));
+                    auto slot = std::make_unique<LazySlot>();
+                    slot->keys.assign(part_keys.begin() + begin, part_keys.begin() + end);
+                    slot->values.assign(part_values.begin() + begin, part_values.begin() + end);
+                    slot->avg_expert_keys = keys.size() / num_experts;
+                    lazy_slots_.resize(experts_.size());
+                    lazy_slots_.push_back(std::move(slot));
+                    experts_.push_back(nullptr);
+                    expert_blooms_.push_back(ExpertBloom(1, config_.bloom_bits_per_key(),
+                                                         ArenaAllocator<uint64_t>(arena)));
+                }
+                continue;
             }
 
-            // Create per-expert Bloom filter
-            BloomFilter expert_bloom(part_keys.size(), config_.bloom_bits_per_key());
-            for (const auto& k : part_keys) {
-                expert_bloom.insert(k);
-            }
-            expert_blooms_.push_back(std::move(expert_bloom));
+            // Expert type chosen from data characteristics and compression level;
+            // per-expert Bloom filter alongside
+            experts_.push_back(build_expert(part_keys, part_values, keys.size() / num_experts, arena));
+            expert_blooms_.push_back(build_expert_bloom(part_keys, arena));
+        }
+        if (!lazy_slots_.empty()) {
+            lazy_slots_.resize(experts_.size());
         }
 
         // Add sentinel boundary (one past last expert)
         expert_boundaries_.push_back(max_global_key + 1);
+        // The global filter holds no keys of a lazy load, so it covers nothing
+        global_bloom_end_ = config_.lazy_build ? std::numeric_limits<KeyType>::min() : max_global_key + 1;
+
+        // Seal the tail at roughly one average expert's worth of keys
+        tail_.clear();
+        tail_capacity_ = std::max(MIN_TAIL_CAPACITY, keys.size() / num_experts);
+
+        // Clear write path
+        delta_buffer_.clear();
+        levels_.clear();
+        compaction_.reset();
+        run_keys_ = 0;
+        reset_merge();
+
+        if (hot_cache_) {
+            hot_cache_->clear();
+        }
+        if (tiering_) {
+            enforce_memory_budget(experts_.size());
+        }
 
-        // Clear delta buffers
-        delta_buffer_art_.clear();
-        delta_buffer_hash_.clear();
+        // Logged updates are superseded by the new base data
+        if (wal_) {
+            wal_->truncate();
+        }
     }
 
     size_t size() const override {
-        if (config_.compression_level < 0.5) {
-            return total_size_ + delta_buffer_hash_.size();
-        } else {
-            return total_size_ + delta_buffer_art_.size();
-        }
+        // Merging keys join total_size_ only once their merge completes
+        return total_size_ + tail_.size() + delta_buffer_.size() + run_keys_ + merging_keys_;
     }
 
     size_t memory_footprint() const override {
         size_t total = 0;
 
-        // Experts
-        for (const auto& expert : experts_) {
-            total += expert->memory_footprint();
+        // Experts (partitions of lazy experts not built yet)
+        for (size_t i = 0; i < experts_.size(); ++i) {
+            if (!expert_built(i)) {
+                total += lazy_slots_[i]->keys.capacity() * sizeof(KeyType) +
+                         lazy_slots_[i]->values.capacity() * sizeof(ValueType);
+                continue;
+            }
+            total += experts_[i]->memory_footprint() + experts_[i]->packed_bytes();
         }
 
         // Bloom filters
@@ -487,11 +1079,42 @@ public:
         // Expert boundaries
         total += expert_boundaries_.capacity() * sizeof(KeyType);
 
-        // Delta buffer
-        if (config_.compression_level < 0.5) {
-            total += delta_buffer_hash_.size() * (sizeof(KeyType) + sizeof(ValueType)) * 1.3;  // Hash table overhead
-        } else {
-            total += delta_buffer_art_.size() * (sizeof(KeyType) + sizeof(ValueType)) * 1.25;  // ART overhead
+        // Append-only tail
+        total += tail_.memory_footprint();
+
+        // Arena slack (huge-page granularity) and bytes of replaced experts;
+        // live arena bytes are counted above
+        total += arena_.bytes_reserved() - arena_.bytes_live();
+
+        // Memtable
+        total += delta_buffer_.size() * (sizeof(KeyType) + sizeof(ValueType)) *
+                 DeltaBufferPolicy::OVERHEAD;
+
+        // Sorted runs (levels and merging)
+        for (const auto& level : levels_) {
+            for (const auto& run : level) {
+                total += run.memory_footprint();
+            }
+        }
+        for (const auto& run : merging_runs_) {
+            total += run.memory_footprint();
+        }
+        if (compaction_) {
+            total += compaction_->keys.capacity() * sizeof(KeyType) +
+                     compaction_->values.capacity() * sizeof(ValueType) +
+                     compaction_->filter.memory_footprint() +
+                     compaction_->erased.size() * sizeof(KeyType) * 1.3;
+        }
+
+        // Merge buckets and tombstones (merging and expert keys)
+        for (const auto& bucket : merge_buckets_) {
+            total += bucket.capacity() * sizeof(std::pair<KeyType, ValueType>);
+        }
+        total += (merge_erased_.size() + expert_erased_.size()) * sizeof(KeyType) * 1.3;
+
+        // Hot-key cache
+        if (hot_cache_) {
+            total += hot_cache_->memory_footprint();
         }
 
         return total;
@@ -499,21 +1122,1173 @@ public:
 
     std::string name() const override {
         char buf[64];
-        snprintf(buf, sizeof(buf), "HALIv2(c=%.2f)", config_.compression_level);
+        snprintf(buf, sizeof(buf), "HALIv2(%s,c=%.2f)", ExpertPolicy::NAME, config_.compression_level);
         return std::string(buf);
     }
 
     void clear() override {
+        release_storage();
+        tail_.clear();
+        delta_buffer_.clear();
+        levels_.clear();
+        compaction_.reset();
+        run_keys_ = 0;
+        reset_merge();
+        total_size_ = 0;
+        if (hot_cache_) {
+            hot_cache_->clear();
+        }
+        if (tiering_) {
+            tiering_->file.reset();
+        }
+        if (wal_) {
+            wal_->truncate();
+        }
+    }
+
+    /**
+     * @brief Attach a write-ahead log and replay it into the delta buffer
+     *
+     * Call after load() of the base data on restart. From then on every
+     * successful insert/erase is logged with group commit; a later load()
+     * or clear() truncates the log.
+     * @return Number of replayed records
+     */
+    size_t open_wal(const std::string& path,
+                    typename WAL::Options options = typename WAL::Options()) {
+        wal_ = std::make_unique<WAL>(path, options);
+        return wal_->replay([this](typename WAL::RecordType type,
+                                   const KeyType& key, const ValueType& value) {
+            if (type == WAL::RecordType::INSERT) {
+                insert_unlogged(key, value);
+            } else {
+                erase_unlogged(key);
+            }
+        });
+    }
+
+    /**
+     * @brief Force pending log records to disk
+     */
+    void sync_wal() {
+        if (wal_) {
+            wal_->flush();
+        }
+    }
+
+    /**
+     * @brief Sync and detach the write-ahead log
+     */
+    void close_wal() {
+        wal_.reset();
+    }
+
+    const WAL* wal() const { return wal_.get(); }
+
+    /**
+     * @brief Put a set-associative cache of hot keys in front of find()
+     *
+     * Pays off under skewed reads, where a few thousand keys take most
+     * lookups: a hit skips the memtable, sorted runs, Bloom filters and
+     * expert search. Inserts and erases invalidate the key's entry. find()
+     * updates the cache, so concurrent readers need external locking while
+     * it is enabled.
+     * @param capacity Number of cached entries (0 disables the cache)
+     */
+    void enable_hot_cache(size_t capacity = 4096) {
+        hot_cache_ = capacity > 0 ? std::make_unique<HotCache>(capacity) : nullptr;
+    }
+
+    void disable_hot_cache() {
+        hot_cache_.reset();
+    }
+
+    const HotCache* hot_cache() const { return hot_cache_.get(); }
+
+    /**
+     * @brief Keep cold experts' key/value arrays in a spill file
+     *
+     * The router, filters, models and ART trees stay in memory, so negative
+     * lookups and routing never touch the disk. The arrays of all experts
+     * count against memory_budget; when they exceed it, the least recently
+     * looked-up experts are written to the spill file (once; the arrays are
+     * immutable) and dropped. A lookup routed to an evicted expert preads
+     * only the keys in its search window plus one value: the model's error
+     * window for PGM/RMI, the single leaf position for ART (whose tree stores
+     * positions, not keys). Once an expert has cost as many bytes of such
+     * reads as its whole arrays, it is read back in full (which may evict
+     * colder experts), so a hot range pays for one fault rather than
+     * thrashing. Like the hot-key cache, this makes find()
+     * update shared state, so concurrent readers need external locking.
+     * @param path Spill file (created, truncated, and removed on disable)
+     * @param memory_budget Bytes of expert arrays allowed to stay in memory
+     */
+    void enable_tiering(const std::string& path, size_t memory_budget) {
+        if (config_.use_arena) {
+            // Arena chunks are only released in bulk, so eviction would free nothing
+            throw std::logic_error("Tiered storage requires use_arena = false");
+        }
+        stop_warmer();
+        disable_tiering();
+        tiering_ = std::make_unique<Tiering>(path, memory_budget);
+        enforce_memory_budget(experts_.size());
+    }
+
+    /**
+     * @brief Read every evicted expert back and remove the spill file
+     */
+    void disable_tiering() {
+        if (!tiering_) {
+            return;
+        }
+        for (const auto& expert : experts_) {
+            if (expert && expert->evicted) {
+                fault_in(*expert);
+            }
+        }
+        tiering_.reset();
+    }
+
+    /**
+     * @brief Compress the arrays of experts that stop seeing lookups
+     *
+     * Every idle_lookups expert lookups, experts not looked up during the
+     * last idle_lookups have their key and value arrays replaced by
+     * FORBlockArray blocks of 128 entries. A lookup on a compressed expert
+     * takes its search window (the model's error bound, or the ART leaf),
+     * picks the single block that can hold the key from the block bases,
+     * decodes just that block and extracts one value. Once an expert has decoded as many bytes as its
+     * arrays hold, it is decompressed again. The automatic sweep is spread
+     * over lookups, compressing at most one expert per lookup;
+     * compress_cold_experts() sweeps everything at once for callers that
+     * prefer to do it off the read path. Sorted keys typically shrink
+     * 3-8x; like tiering, this needs use_arena = false and makes find()
+     * update shared state.
+     * @param idle_lookups Expert lookups without a hit before an expert counts as cold
+     */
+    void enable_cold_compression(uint64_t idle_lookups = 1000000) {
+        if (config_.use_arena) {
+            throw std::logic_error("Cold compression requires use_arena = false");
+        }
+        stop_warmer();
+        compression_ = std::make_unique<ColdCompression>();
+        compression_->idle_lookups = std::max<uint64_t>(1, idle_lookups);
+        compression_->next_sweep = access_clock_ + compression_->idle_lookups;
+    }
+
+    /**
+     * @brief Decompress every expert and stop compressing
+     */
+    void disable_cold_compression() {
+        for (const auto& expert : experts_) {
+            if (expert && expert->compressed) {
+                inflate(*expert);
+            }
+        }
+        compression_.reset();
+    }
+
+    /**
+     * @brief Compress now every expert idle for at least idle_lookups (0 = all)
+     * @return Number of experts compressed
+     */
+    size_t compress_cold_experts(uint64_t idle_lookups) {
+        if (!compression_) {
+            throw std::logic_error("Cold compression is not enabled");
+        }
+        return sweep_cold_experts(idle_lookups);
+    }
+
+    size_t num_compressed_experts() const {
+        size_t count = 0;
+        for (const auto& expert : experts_) {
+            count += expert && expert->compressed;
+        }
+        return count;
+    }
+
+    size_t blocks_decoded() const { return compression_ ? compression_->blocks_decoded : 0; }
+
+    /**
+     * @brief Defer expert training to first access for fast time-to-first-query
+     *
+     * A lazy load() only sorts and partitions the data and sets up the
+     * router; each expert's model and Bloom filter are built the first time
+     * a lookup routes to it (std::call_once, so concurrent readers build it
+     * once), or earlier by start_warmer(). The global Bloom filter is not
+     * built for lazily loaded keys; per-expert filters still reject
+     * negative lookups. Takes effect at the next load().
+     */
+    void set_lazy_build(bool lazy) {
+        if (lazy && config_.use_arena) {
+            // Experts built by concurrent readers would race on the bump pointer
+            throw std::logic_error("Lazy build requires use_arena = false");
+        }
+        config_.lazy_build = lazy;
+    }
+
+    /**
+     * @brief Build the remaining lazy experts on a background thread
+     *
+     * find() may run concurrently with the warmer; updates and structural
+     * operations stop it first (pending experts are then built on access).
+     * Not available together with tiering or cold compression, whose
+     * lookups scan all experts.
+     */
+    void start_warmer() {
+        if (tiering_ || compression_) {
+            throw std::logic_error("Warmer cannot run with tiering or cold compression enabled");
+        }
+        stop_warmer();
+        if (lazy_slots_.empty()) {
+            return;
+        }
+        warmer_ = std::make_unique<Warmer>();
+        Warmer* warmer = warmer_.get();
+        warmer_->thread = std::thread([this, warmer]() {
+            for (size_t i = 0; i < lazy_slots_.size(); ++i) {
+                if (warmer->stop.load(std::memory_order_relaxed)) {
+                    break;
+                }
+                ensure_built(i);
+            }
+        });
+    }
+
+    /**
+     * @brief Block until the warmer has built every pending expert
+     */
+    void wait_warmer() {
+        if (warmer_) {
+            warmer_->thread.join();
+            warmer_.reset();
+        }
+    }
+
+    /**
+     * @brief Interrupt the warmer and join it
+     */
+    void stop_warmer() {
+        if (warmer_) {
+            warmer_->stop.store(true, std::memory_order_relaxed);
+            warmer_->thread.join();
+            warmer_.reset();
+        }
+    }
+
+    /**
+     * @brief Experts whose model and filter are not built yet
+     */
+    size_t num_pending_experts() const {
+        size_t pending = 0;
+        for (size_t i = 0; i < experts_.size(); ++i) {
+            pending += !expert_built(i);
+        }
+        return pending;
+    }
+
+    bool tiering_enabled() const { return tiering_ != nullptr; }
+    size_t expert_faults() const { return tiering_ ? tiering_->faults : 0; }
+    size_t expert_evictions() const { return tiering_ ? tiering_->evictions : 0; }
+    const SpillFile* spill_file() const { return tiering_ ? &tiering_->file : nullptr; }
+
+    /**
+     * @brief Bytes of expert arrays currently in memory
+     */
+    size_t resident_expert_bytes() const {
+        size_t total = 0;
+        for (const auto& expert : experts_) {
+            if (expert) {
+                total += expert->data_bytes();
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Run one bounded slice of an in-progress run-to-expert merge
+     *
+     * Once the sorted runs hold more than merge_threshold of the main index,
+     * all of them are handed to the merge (an O(1) move) and fresh levels
+     * take new flushes. The merge then advances one slice per memtable
+     * insert: COLLECT routes at most MERGE_SLICE_KEYS run entries into
+     * per-expert buckets, and REBUILD merges one expert's bucket into a new
+     * expert and swaps it in. Rebuilt experts are split to about
+     * MERGE_EXPERT_KEYS, so after an expert's first rebuild every slice is
+     * bounded by a fixed number of keys. Callers with idle time may call
+     * this directly to finish a merge sooner.
+     * @return true while the merge still has work left
+     */
+    bool merge_step() {
+        switch (merge_phase_) {
+            case MergePhase::IDLE:
+                return false;
+
+            case MergePhase::COLLECT: {
+                if (collect_slice()) {
+                    merge_phase_ = MergePhase::REBUILD;
+                    merge_cursor_ = 0;
+                }
+                return true;
+            }
+
+            case MergePhase::REBUILD:
+                skip_empty_buckets();
+                if (merge_cursor_ < experts_.size()) {
+                    std::vector<std::pair<KeyType, ValueType>> bucket =
+                        std::move(merge_buckets_[merge_cursor_]);
+                    merge_cursor_ += rebuild_expert(merge_cursor_, std::move(bucket));
+                    skip_empty_buckets();
+                }
+                if (merge_cursor_ >= experts_.size()) {
+                    finish_merge();
+                    return false;
+                }
+                return true;
+        }
+        return false;
+    }
+
+    bool merge_in_progress() const { return merge_phase_ != MergePhase::IDLE; }
+    size_t merges_completed() const { return merges_completed_; }
+
+    /**
+     * @brief Run one bounded slice of an in-progress level compaction
+     *
+     * A level holding more than LEVEL_FANOUT runs is compacted into one run
+     * of the next level a slice per memtable insert, so the insert that
+     * overflows a level does not pay for rewriting it. A slice first merges
+     * up to COMPACTION_SLICE_KEYS input entries, filling the output's filter
+     * and model sums on the way, then records the model's error over as many
+     * output entries; the finished run replaces its inputs by moves. The
+     * inputs stay readable and erasable until then.
+     * @return true while the compaction still has work left
+     */
+    bool compaction_step() {
+        if (!compaction_) {
+            return false;
+        }
+        Compaction& c = *compaction_;
+
+        if (!c.merged) {
+            const auto& inputs = levels_[c.level];
+            for (size_t n = 0; n < COMPACTION_SLICE_KEYS; ++n) {
+                // Keys are unique across runs, so the smallest head is the next entry
+                size_t next = c.inputs;
+                for (size_t r = 0; r < c.inputs; ++r) {
+                    if (c.cursors[r] < inputs[r].keys.size() &&
+                        (next == c.inputs ||
+                         inputs[r].keys[c.cursors[r]] < inputs[next].keys[c.cursors[next]])) {
+                        next = r;
+                    }
+                }
+                if (next == c.inputs) {
+                    c.merged = true;
+                    c.model.fit(c.sums);
+                    return true;
+                }
+
+                const SortedRun& run = inputs[next];
+                size_t pos = c.cursors[next]++;
+                if (!run.dead[pos]) {
+                    c.sums.add(run.keys[pos], c.keys.size());
+                    c.filter.insert(run.keys[pos]);
+                    c.keys.push_back(run.keys[pos]);
+                    c.values.push_back(run.values[pos]);
+                }
+            }
+            return true;
+        }
+
+        if (c.error_pos < c.keys.size()) {
+            size_t end = std::min(c.keys.size(), c.error_pos + COMPACTION_SLICE_KEYS);
+            c.model.extend_errors(c.keys, c.keys.size() - 1, c.error_pos, end);
+            c.error_pos = end;
+            return true;
+        }
+
+        finish_compaction();
+        return compaction_ != nullptr;
+    }
+
+    bool compaction_in_progress() const { return compaction_ != nullptr; }
+
+    size_t num_experts() const { return experts_.size(); }
+
+    size_t num_runs() const {
+        size_t runs = merging_runs_.size();
+        for (const auto& level : levels_) {
+            runs += level.size();
+        }
+        return runs;
+    }
+
+private:
+    /**
+     * @brief Levels 2-6 of find(): the router, filters and experts
+     */
+    std::optional<ValueType> find_in_experts(const KeyType& key) const {
+        // Level 2: Query main index
+        if (experts_.empty()) {
+            return std::nullopt;
+        }
+
+        // Level 3: Check global Bloom filter for fast negative lookup
+        // (Only check after delta buffer, since Bloom filter doesn't include delta keys
+        // or experts sealed from the tail after load)
+        if constexpr (FilterPolicy::ENABLED) {
+            if (key < global_bloom_end_ && !global_bloom_.contains(key)) {
+                return std::nullopt;  // Definitely not in main index
+            }
+        }
+
+        // Level 4: Binary search over expert boundaries to find correct expert
+        size_t expert_id = route_to_expert(key);
+
+        if (expert_id >= experts_.size()) {
+            return std::nullopt;
+        }
+        ensure_built(expert_id);
+
+        // Level 5: Check expert Bloom filter (RE-ENABLED with safety check)
+        if constexpr (FilterPolicy::ENABLED) {
+            if (expert_id < expert_blooms_.size() && !expert_blooms_[expert_id].contains(key)) {
+                // Bloom filter says key is not in this expert
+                // But due to range-based partitioning, let's double-check the key is within bounds
+                if (expert_id < experts_.size()) {
+                    const auto& expert = experts_[expert_id];
+                    if (key < expert->min_key || key > expert->max_key) {
+                        // Key is definitely outside this expert's range
+                        return std::nullopt;
+                    }
+                    // Key might be in expert's range but Bloom filter gives false negative
+                    // This can happen with hash collisions - proceed to expert query
+                } else {
+                    return std::nullopt;
+                }
+            }
+        }
+
+        // Erased since the expert was last rebuilt (the set is usually empty)
+        if (!expert_erased_.empty() && expert_erased_.count(key) > 0) {
+            return std::nullopt;
+        }
+
+        // Level 6: Query expert (from the spill file or packed blocks if cold)
+        if (tiering_ || compression_) {
+            return find_cold(expert_id, key);
+        }
+        return experts_[expert_id]->find(key);
+    }
+
+    bool insert_unlogged(const KeyType& key, const ValueType& value) {
+        // Check if key already exists
+        if (find_uncached(key).has_value()) {
+            return false;
+        }
+        if (hot_cache_) {
+            hot_cache_->invalidate(key);
+        }
+
+        // In-order keys past the indexed range go to the append-only tail
+        // (paused during a merge, which may extend the last expert's range)
+        if (merge_phase_ == MergePhase::IDLE &&
+            (experts_.empty() || key >= expert_boundaries_.back()) && tail_.accepts(key)) {
+            tail_.append(key, value);
+            if (tail_.size() >= tail_capacity_) {
+                seal_tail();
+            }
+            return true;
+        }
+
+        // Insert into the memtable
+        bool inserted = delta_buffer_.insert({key, value}).second;
+
+        if (inserted) {
+            if (delta_buffer_.size() >= MEMTABLE_KEYS) {
+                flush_memtable();
+            }
+            compaction_step();
+            advance_merge();
+        }
+        return inserted;
+    }
+
+    bool erase_unlogged(const KeyType& key) {
+        if (hot_cache_) {
+            hot_cache_->invalidate(key);
+        }
+
+        if (tail_.erase(key)) {
+            return true;
+        }
+
+        if (delta_buffer_.erase(key) > 0) {
+            return true;
+        }
+        for (size_t level = 0; level < levels_.size(); ++level) {
+            for (size_t r = 0; r < levels_[level].size(); ++r) {
+                if (!levels_[level][r].erase(key)) {
+                    continue;
+                }
+                run_keys_--;
+                // The compaction output may already hold a copy
+                if (compaction_ && level == compaction_->level && r < compaction_->inputs) {
+                    compaction_->erased.insert(key);
+                }
+                return true;
+            }
+        }
+
+        for (auto& run : merging_runs_) {
+            if (!run.erase(key)) {
+                continue;
+            }
+            merging_keys_--;
+
+            // COLLECT may already have copied the key into a bucket; an expert
+            // already rebuilt with it is rebuilt again without it
+            merge_erased_.insert(key);
+            if (merge_phase_ == MergePhase::REBUILD) {
+                size_t expert_id = route_to_expert(key);
+                if (expert_id < merge_cursor_) {
+                    merge_cursor_ += rebuild_expert(expert_id, {}) - 1;
+                }
+            }
+            return true;
+        }
+
+        // Expert keys (loaded, sealed from the tail or merged from runs) are
+        // tombstoned until their expert is next rebuilt
+        if (find_in_experts(key).has_value()) {
+            expert_erased_.insert(key);
+            total_size_--;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Freeze the memtable into a level-0 sorted run
+     */
+    void flush_memtable() {
+        std::vector<std::pair<KeyType, ValueType>> entries(delta_buffer_.begin(), delta_buffer_.end());
+        std::sort(entries.begin(), entries.end());
+        delta_buffer_.clear();
+        add_run(0, entries);
+    }
+
+    /**
+     * @brief Append a run built from sorted entries to a level; start a
+     * compaction if a level is now full
+     */
+    void add_run(size_t level, const std::vector<std::pair<KeyType, ValueType>>& entries) {
+        std::vector<KeyType> run_keys;
+        std::vector<ValueType> run_values;
+        run_keys.reserve(entries.size());
+        run_values.reserve(entries.size());
+        for (const auto& kv : entries) {
+            run_keys.push_back(kv.first);
+            run_values.push_back(kv.second);
+        }
+
+        if (levels_.size() <= level) {
+            levels_.resize(level + 1);
+        }
+        levels_[level].emplace_back(std::move(run_keys), std::move(run_values),
+                                    config_.bloom_bits_per_key());
+        run_keys_ += entries.size();
+
+        if (!compaction_) {
+            begin_compaction();
+        }
+    }
+
+    /**
+     * @brief Start compacting the lowest level holding more than LEVEL_FANOUT runs
+     */
+    void begin_compaction() {
+        for (size_t level = 0; level < levels_.size(); ++level) {
+            if (levels_[level].size() <= LEVEL_FANOUT) {
+                continue;
+            }
+            size_t live = 0;
+            for (const auto& run : levels_[level]) {
+                live += run.live();
+            }
+
+            compaction_ = std::make_unique<Compaction>();
+            compaction_->level = level;
+            compaction_->inputs = levels_[level].size();
+            compaction_->cursors.assign(compaction_->inputs, 0);
+            compaction_->keys.reserve(live);
+            compaction_->values.reserve(live);
+            compaction_->filter = ExpertBloom(std::max(size_t(1), live), config_.bloom_bits_per_key());
+            return;
+        }
+    }
+
+    /**
+     * @brief Replace the compacted inputs by the output run in the next level
+     */
+    void finish_compaction() {
+        Compaction& c = *compaction_;
+        auto& inputs = levels_[c.level];
+        for (size_t r = 0; r < c.inputs; ++r) {
+            run_keys_ -= inputs[r].live();
+        }
+        inputs.erase(inputs.begin(), inputs.begin() + c.inputs);
+
+        SortedRun run(std::move(c.keys), std::move(c.values), c.model, std::move(c.filter));
+        for (const auto& key : c.erased) {
+            run.erase(key);
+        }
+        run_keys_ += run.live();
+        if (run.live() > 0) {
+            if (levels_.size() <= c.level + 1) {
+                levels_.resize(c.level + 2);
+            }
+            levels_[c.level + 1].push_back(std::move(run));
+        }
+
+        compaction_.reset();
+        begin_compaction();
+    }
+
+    /**
+     * @brief Turn the full tail into a regular expert appended to the router
+     *
+     * The new expert owns [old sentinel, tail max]; the sentinel moves past it.
+     * Like merged experts, it lives on the heap (see build_expert()).
+     */
+    void seal_tail() {
+        stop_warmer();  // experts_ may reallocate
+        std::vector<KeyType> part_keys(tail_.keys.begin(), tail_.keys.end());
+        std::vector<ValueType> part_values(tail_.values.begin(), tail_.values.end());
+        KeyType min_key = part_keys.front();
+        KeyType max_key = part_keys.back();
+
+        experts_.push_back(build_expert(part_keys, part_values, tail_capacity_, nullptr));
+        expert_blooms_.push_back(build_expert_bloom(part_keys, nullptr));
+        if (!lazy_slots_.empty()) {
+            lazy_slots_.push_back(nullptr);
+        }
+
+        if (expert_boundaries_.empty()) {
+            expert_boundaries_.push_back(min_key);
+        }
+        // Old sentinel becomes the new expert's lower boundary
+        expert_boundaries_.push_back(max_key + 1);
+
+        total_size_ += part_keys.size();
+        tail_.clear();
+
+        if (tiering_) {
+            enforce_memory_budget(experts_.size() - 1);
+        }
+    }
+
+    /**
+     * @brief Build the expert for one sorted partition
+     *
+     * The expert type follows select_expert_type(); PGM experts get an
+     * epsilon sized against avg_expert_keys. Only load() passes the arena:
+     * the arena never frees single allocations, so experts that replace or
+     * extend loaded ones are built on the heap (arena == nullptr) and the
+     * arena stays bounded by the loaded data.
+     */
+    std::unique_ptr<Expert> build_expert(const std::vector<KeyType>& part_keys,
+                                         const std::vector<ValueType>& part_values,
+                                         size_t avg_expert_keys, Arena* arena) {
+        KeyType min_key = part_keys.front();
+        KeyType max_key = part_keys.back();
+
+        ExpertType type = select_expert_type(part_keys);
+        std::unique_ptr<Expert> expert;
+        if constexpr (ExpertPolicy::USE_PGM) {
+            if (type == ExpertType::PGM) {
+                size_t epsilon = select_pgm_epsilon(part_keys.size(), avg_expert_keys);
+                expert = make_pgm_expert(epsilon, part_keys, part_values, min_key, max_key, arena);
+            }
+        }
+        if (!expert) {
+            if (type == ExpertType::RMI) {
+                expert = std::make_unique<RMIExpert>(part_keys, part_values, min_key, max_key, arena);
+            } else {
+                expert = std::make_unique<ARTExpert>(part_keys, part_values, min_key, max_key, arena);
+            }
+        }
+
+        // New experts count as just looked up, so cold sweeps and LRU
+        // eviction start with the older ones
+        expert->last_access = access_clock_;
+        return expert;
+    }
+
+    ExpertBloom build_expert_bloom(const std::vector<KeyType>& part_keys, Arena* arena) {
+        ExpertBloom expert_bloom(std::max(size_t(1), part_keys.size()), config_.bloom_bits_per_key(),
+                                 ArenaAllocator<uint64_t>(arena));
+        for (const auto& k : part_keys) {
+            expert_bloom.insert(k);
+        }
+        return expert_bloom;
+    }
+
+    /**
+     * @brief Pay for one merge slice per memtable insert; hand the runs to a
+     * new merge once they exceed merge_threshold of the main index
+     */
+    void advance_merge() {
+        if (merge_phase_ != MergePhase::IDLE) {
+            merge_step();
+            return;
+        }
+
+        size_t threshold = std::max(MIN_MERGE_KEYS,
+                                    static_cast<size_t>(config_.merge_threshold * total_size_));
+        if (!experts_.empty() && run_keys_ >= threshold) {
+            begin_merge();
+        }
+    }
+
+    void begin_merge() {
+        // Tail keys would overlap the last expert's range once it absorbs
+        // run keys past the sentinel, so seal the tail first
+        if (!tail_.empty()) {
+            seal_tail();
+        }
+
+        for (auto& level : levels_) {
+            for (auto& run : level) {
+                merging_runs_.push_back(std::move(run));
+            }
+        }
+        levels_.clear();
+        compaction_.reset();  // Its inputs are merging as they are
+        merging_keys_ = run_keys_;
+        run_keys_ = 0;
+        collect_run_ = 0;
+        collect_pos_ = 0;
+
+        merge_buckets_.assign(experts_.size(), {});
+        merge_cursor_ = 0;
+        merge_phase_ = MergePhase::COLLECT;
+    }
+
+    /**
+     * @brief Route up to MERGE_SLICE_KEYS live run entries to their experts' buckets
+     * @return true once every merging run has been routed
+     */
+    bool collect_slice() {
+        size_t n = 0;
+        while (collect_run_ < merging_runs_.size() && n < MERGE_SLICE_KEYS) {
+            const SortedRun& run = merging_runs_[collect_run_];
+            for (; collect_pos_ < run.keys.size() && n < MERGE_SLICE_KEYS; ++collect_pos_, ++n) {
+                if (!run.dead[collect_pos_]) {
+                    merge_buckets_[route_to_expert(run.keys[collect_pos_])].push_back(
+                        {run.keys[collect_pos_], run.values[collect_pos_]});
+                }
+            }
+            if (collect_pos_ == run.keys.size()) {
+                ++collect_run_;
+                collect_pos_ = 0;
+            }
+        }
+        return collect_run_ == merging_runs_.size();
+    }
+
+    void skip_empty_buckets() {
+        while (merge_cursor_ < experts_.size() && merge_buckets_[merge_cursor_].empty()) {
+            ++merge_cursor_;
+        }
+    }
+
+    /**
+     * @brief Replace expert expert_id by its keys merged with bucket
+     *
+     * Keys erased mid-merge and the expert's tombstoned keys are dropped.
+     * A result larger than twice the split target is cut into equal parts
+     * of about that size so that later rebuilds (and their pauses) stay
+     * bounded. The new experts are built on the heap; the old one's arena
+     * bytes, if any, stay reserved until the next load() or clear().
+     * @return Number of experts now occupying the slot
+     */
+    size_t rebuild_expert(size_t expert_id, std::vector<std::pair<KeyType, ValueType>> bucket) {
+        std::sort(bucket.begin(), bucket.end());
+        stop_warmer();
+        ensure_built(expert_id);
+        if (tiering_ || compression_) {
+            make_resident(expert_id);
+        }
+        const Expert& old = *experts_[expert_id];
+
+        std::vector<KeyType> merged_keys;
+        std::vector<ValueType> merged_values;
+        merged_keys.reserve(old.keys.size() + bucket.size());
+        merged_values.reserve(old.keys.size() + bucket.size());
+
+        size_t i = 0, j = 0;
+        while (i < old.keys.size() || j < bucket.size()) {
+            bool from_old = j == bucket.size() ||
+                            (i < old.keys.size() && old.keys[i] < bucket[j].first);
+            KeyType key = from_old ? old.keys[i] : bucket[j].first;
+            ValueType value = from_old ? old.values[i++] : bucket[j++].second;
+            // A tombstoned key may come back in the bucket after its re-insert
+            if (from_old && expert_erased_.erase(key) > 0) {
+                continue;
+            }
+            if (merge_erased_.count(key) > 0) {
+                continue;
+            }
+            if (!from_old) {
+                global_bloom_.insert(key);
+            }
+            merged_keys.push_back(key);
+            merged_values.push_back(value);
+        }
+
+        size_t n = merged_keys.size();
+        size_t target = std::min(tail_capacity_, MERGE_EXPERT_KEYS);
+        size_t parts = (n > 2 * target) ? (n + target - 1) / target : 1;
+
+        std::vector<std::unique_ptr<Expert>> new_experts;
+        std::vector<ExpertBloom> new_blooms;
+        std::vector<KeyType> new_boundaries;
+
+        if (n == 0) {
+            // Everything erased: keep an empty placeholder for the range
+            new_experts.push_back(std::make_unique<ARTExpert>(
+                std::vector<KeyType>(), std::vector<ValueType>(), old.min_key, old.max_key,
+                nullptr));
+            new_blooms.push_back(build_expert_bloom({}, nullptr));
+            new_boundaries.push_back(expert_boundaries_[expert_id]);
+        }
+        for (size_t p = 0; p < parts && n > 0; ++p) {
+            size_t begin = p * n / parts;
+            size_t end = (p + 1) * n / parts;
+            std::vector<KeyType> part_keys(merged_keys.begin() + begin, merged_keys.begin() + end);
+            std::vector<ValueType> part_values(merged_values.begin() + begin, merged_values.begin() + end);
+
+            new_experts.push_back(build_expert(part_keys, part_values, tail_capacity_, nullptr));
+            new_blooms.push_back(build_expert_bloom(part_keys, nullptr));
+            // Only expert 0 can receive keys below its boundary
+            new_boundaries.push_back(p == 0 ?
+                std::min(expert_boundaries_[expert_id], part_keys.front()) : part_keys.front());
+        }
+
+        bool is_last = expert_id + 1 == experts_.size();
+        if (tiering_ && old.spilled) {
+            tiering_->file.release(old.spilled_keys * (sizeof(KeyType) + sizeof(ValueType)));
+        }
+
+        experts_[expert_id] = std::move(new_experts[0]);
+        expert_blooms_[expert_id] = std::move(new_blooms[0]);
+        expert_boundaries_[expert_id] = new_boundaries[0];
+
+        experts_.insert(experts_.begin() + expert_id + 1,
+                        std::make_move_iterator(new_experts.begin() + 1),
+                        std::make_move_iterator(new_experts.end()));
+        expert_blooms_.insert(expert_blooms_.begin() + expert_id + 1,
+                              std::make_move_iterator(new_blooms.begin() + 1),
+                              std::make_move_iterator(new_blooms.end()));
+        expert_boundaries_.insert(expert_boundaries_.begin() + expert_id + 1,
+                                  new_boundaries.begin() + 1, new_boundaries.end());
+        merge_buckets_.insert(merge_buckets_.begin() + expert_id + 1, new_experts.size() - 1,
+                              std::vector<std::pair<KeyType, ValueType>>());
+        if (!lazy_slots_.empty()) {
+            lazy_slots_[expert_id].reset();
+            std::vector<std::unique_ptr<LazySlot>> built_slots(new_experts.size() - 1);
+            lazy_slots_.insert(lazy_slots_.begin() + expert_id + 1,
+                               std::make_move_iterator(built_slots.begin()),
+                               std::make_move_iterator(built_slots.end()));
+        }
+
+        // The last expert absorbs keys past the sentinel
+        if (is_last && n > 0) {
+            expert_boundaries_.back() = std::max(expert_boundaries_.back(), merged_keys.back() + 1);
+        }
+
+        if (tiering_) {
+            enforce_memory_budget(expert_id);
+        }
+
+        return new_experts.size();
+    }
+
+    void finish_merge() {
+        total_size_ += merging_keys_;
+        reset_merge();
+        merges_completed_++;
+    }
+
+    void reset_merge() {
+        merging_runs_.clear();
+        merging_keys_ = 0;
+        merge_erased_.clear();
+        merge_buckets_.clear();
+        merge_cursor_ = 0;
+        merge_phase_ = MergePhase::IDLE;
+    }
+
+    bool expert_built(size_t expert_id) const {
+        return lazy_slots_.empty() || !lazy_slots_[expert_id] ||
+               lazy_slots_[expert_id]->built.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Train a lazily loaded expert and its filter on first use
+     *
+     * Logically const: load() fixed the expert's contents. A build writes
+     * only its own experts_/expert_blooms_ element, so different experts
+     * can be built by concurrent readers and the warmer at the same time.
+     */
+    void ensure_built(size_t expert_id) const {
+        if (expert_built(expert_id)) {
+            return;
+        }
+        LazySlot& slot = *lazy_slots_[expert_id];
+        std::call_once(slot.once, [this, expert_id, &slot]() {
+            auto* self = const_cast<HALIv2Index*>(this);
+            self->experts_[expert_id] = self->build_expert(slot.keys, slot.values,
+                                                           slot.avg_expert_keys, nullptr);
+            self->expert_blooms_[expert_id] = self->build_expert_bloom(slot.keys, nullptr);
+            std::vector<KeyType>().swap(slot.keys);
+            std::vector<ValueType>().swap(slot.values);
+            slot.built.store(true, std::memory_order_release);
+        });
+    }
+
+    /**
+     * @brief Look key up in an expert that may be evicted or compressed
+     *
+     * Reached from find(): experts and tiering/compression state sit behind
+     * unique_ptrs, which is what lets a const lookup change their form.
+     */
+    std::optional<ValueType> find_cold(size_t expert_id, KeyType key) const {
+        Expert& expert = *experts_[expert_id];
+        expert.last_access = ++access_clock_;
+        if (compression_) {
+            sweep_step();
+        }
+
+        if (expert.compressed) {
+            return find_compressed(expert_id, key);
+        }
+        if (!expert.evicted) {
+            return expert.find(key);
+        }
+
+        size_t n = expert.spilled_keys;
+        auto [lo, hi] = expert.search_window(key, n);
+        expert.cold_bytes_read += (hi - lo) * sizeof(KeyType) + sizeof(ValueType);
+        if (expert.cold_bytes_read >= n * (sizeof(KeyType) + sizeof(ValueType))) {
+            // Window reads have cost as much as the whole expert: keep it
+            make_resident(expert_id);
+            return expert.find(key);
+        }
+
+        std::vector<KeyType> window(hi - lo);
+        tiering_->file.read(expert.spill_offset + lo * sizeof(KeyType),
+                            window.data(), window.size() * sizeof(KeyType));
+        auto it = std::lower_bound(window.begin(), window.end(), key);
+        if (it == window.end() || *it != key) {
+            return std::nullopt;
+        }
+
+        ValueType value;
+        size_t idx = lo + std::distance(window.begin(), it);
+        tiering_->file.read(expert.spill_offset + n * sizeof(KeyType) + idx * sizeof(ValueType),
+                            &value, sizeof(ValueType));
+        return value;
+    }
+
+    std::optional<ValueType> find_compressed(size_t expert_id, KeyType key) const {
+        Expert& expert = *experts_[expert_id];
+        size_t n = expert.packed_keys.size();
+        expert.cold_bytes_read += FORBlockArray<KeyType>::BLOCK * sizeof(KeyType) + sizeof(ValueType);
+        if (expert.cold_bytes_read >= n * (sizeof(KeyType) + sizeof(ValueType))) {
+            // Decoding has cost as much as the whole expert: keep it plain
+            make_resident(expert_id);
+            return expert.find(key);
+        }
+
+        auto [lo, hi] = expert.search_window(key, n);
+        size_t idx = expert.packed_keys.lower_bound(lo, hi, key);
+        compression_->blocks_decoded++;
+        if (idx == hi || expert.packed_keys.get(idx) != key) {
+            return std::nullopt;
+        }
+        return expert.packed_values.get(idx);
+    }
+
+    /**
+     * @brief Mark an expert most recently used and restore its plain arrays
+     */
+    void make_resident(size_t expert_id) const {
+        Expert& expert = *experts_[expert_id];
+        expert.last_access = ++access_clock_;
+        if (expert.compressed) {
+            inflate(expert);
+        }
+        if (expert.evicted) {
+            fault_in(expert);
+        }
+        if (tiering_) {
+            enforce_memory_budget(expert_id);
+        }
+    }
+
+    /**
+     * @brief Compress experts idle for at least idle_lookups
+     */
+    size_t sweep_cold_experts(uint64_t idle_lookups) const {
+        size_t count = 0;
+        for (const auto& expert : experts_) {
+            if (is_cold(expert.get(), idle_lookups)) {
+                compress(*expert);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Advance the automatic sweep from inside one lookup
+     *
+     * A sweep starts every idle_lookups expert lookups and walks the experts
+     * across the following lookups: each checks at most COLD_SWEEP_SCAN
+     * experts and compresses at most one, so no find() pays for encoding
+     * more than one expert.
+     */
+    void sweep_step() const {
+        ColdCompression& cc = *compression_;
+        if (cc.sweep_cursor >= experts_.size()) {
+            if (access_clock_ < cc.next_sweep) {
+                return;
+            }
+            cc.sweep_cursor = 0;
+            cc.next_sweep = access_clock_ + cc.idle_lookups;
+        }
+        size_t end = std::min(experts_.size(), cc.sweep_cursor + COLD_SWEEP_SCAN);
+        while (cc.sweep_cursor < end) {
+            Expert* expert = experts_[cc.sweep_cursor++].get();
+            if (is_cold(expert, cc.idle_lookups)) {
+                compress(*expert);
+                return;
+            }
+        }
+    }
+
+    bool is_cold(const Expert* expert, uint64_t idle_lookups) const {
+        return expert && !expert->compressed && !expert->evicted && !expert->keys.empty() &&
+               access_clock_ - expert->last_access >= idle_lookups;
+    }
+
+    void compress(Expert& expert) const {
+        expert.packed_keys = FORBlockArray<KeyType>(expert.keys);
+        expert.packed_values = FORBlockArray<ValueType>(expert.values);
+        KeyArray().swap(expert.keys);
+        ValueArray().swap(expert.values);
+        expert.compressed = true;
+        expert.cold_bytes_read = 0;
+        compression_->compressions++;
+    }
+
+    void inflate(Expert& expert) const {
+        size_t n = expert.packed_keys.size();
+        expert.keys = KeyArray(n);
+        expert.values = ValueArray(n);
+        expert.packed_keys.decode_all(expert.keys.data());
+        expert.packed_values.decode_all(expert.values.data());
+        expert.packed_keys = FORBlockArray<KeyType>();
+        expert.packed_values = FORBlockArray<ValueType>();
+        expert.compressed = false;
+        if (compression_) {
+            compression_->inflations++;
+        }
+    }
+
+    void fault_in(Expert& expert) const {
+        size_t n = expert.spilled_keys;
+        expert.keys = KeyArray(n);
+        expert.values = ValueArray(n);
+        tiering_->file.read(expert.spill_offset, expert.keys.data(), n * sizeof(KeyType));
+        tiering_->file.read(expert.spill_offset + n * sizeof(KeyType),
+                            expert.values.data(), n * sizeof(ValueType));
+        expert.evicted = false;
+        tiering_->faults++;
+    }
+
+    void evict(Expert& expert) const {
+        if (!expert.spilled) {
+            size_t n = expert.keys.size();
+            expert.spill_offset = tiering_->file.append(expert.keys.data(), n * sizeof(KeyType));
+            tiering_->file.append(expert.values.data(), n * sizeof(ValueType));
+            expert.spilled_keys = n;
+            expert.spilled = true;
+        }
+        KeyArray().swap(expert.keys);
+        ValueArray().swap(expert.values);
+        expert.evicted = true;
+        expert.cold_bytes_read = 0;
+        tiering_->evictions++;
+    }
+
+    /**
+     * @brief Evict least recently used experts until their resident
+     * arrays fit the memory budget
+     * @param pinned Expert that must stay resident, or experts_.size() for none
+     */
+    void enforce_memory_budget(size_t pinned) const {
+        size_t resident = 0;
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < experts_.size(); ++i) {
+            if (!experts_[i]) {
+                continue;  // Lazy expert not built yet
+            }
+            const Expert& expert = *experts_[i];
+            if (expert.evicted || expert.keys.empty()) {
+                continue;
+            }
+            resident += expert.data_bytes();
+            if (i != pinned) {
+                candidates.push_back(i);
+            }
+        }
+        if (resident <= tiering_->memory_budget) {
+            return;
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [this](size_t a, size_t b) {
+            return experts_[a]->last_access < experts_[b]->last_access;
+        });
+        for (size_t id : candidates) {
+            if (resident <= tiering_->memory_budget) {
+                break;
+            }
+            resident -= experts_[id]->data_bytes();
+            evict(*experts_[id]);
+        }
+    }
+
+    Arena* storage_arena() {
+        return config_.use_arena ? &arena_ : nullptr;
+    }
+
+    /**
+     * @brief Destroy experts and filters, then release the arena in one step
+     */
+    void release_storage() {
+        stop_warmer();
+        lazy_slots_.clear();
         experts_.clear();
         expert_boundaries_.clear();
         expert_blooms_.clear();
-        global_bloom_.clear();
-        delta_buffer_art_.clear();
-        delta_buffer_hash_.clear();
-        total_size_ = 0;
+        expert_erased_.clear();
+        global_bloom_ = ExpertBloom();
+        arena_.release();
     }
 
-private:
     /**
      * @brief Route key to correct expert using binary search
      * @return expert index (guaranteed correct, no fallback needed)
@@ -551,7 +2326,7 @@ private:
     }
 
     /**
-     * @brief Select expert type based on data linearity and compression level
+     * @brief Select expert type based on data linearity and the expert policy
      */
     ExpertType select_expert_type(const std::vector<KeyType>& keys) const {
         if (keys.size() < 100) {
@@ -559,25 +2334,51 @@ private:
         }
 
         // Calculate linearity score (R² coefficient)
-        double linearity = measure_linearity(keys);
-
-        // Adjust thresholds based on compression level
-        if (config_.compression_level < 0.3) {
-            // Speed mode: prefer ART (fast but more memory)
-            return linearity > 0.90 ? ExpertType::RMI : ExpertType::ART;
-        } else if (config_.compression_level > 0.7) {
-            // Memory mode: prefer PGM (compact)
-            return linearity > 0.70 ? ExpertType::PGM : ExpertType::RMI;
-        } else {
-            // Balanced mode: original heuristic
-            if (linearity > 0.95) {
-                return ExpertType::PGM;
-            } else if (linearity > 0.80) {
-                return ExpertType::RMI;
-            } else {
-                return ExpertType::ART;
+        return ExpertPolicy::select(measure_linearity(keys));
+    }
+
+    /**
+     * @brief Pick the PGM error bound for one expert
+     *
+     * The compression level sets the base epsilon (0.0 → 16, 1.0 → 256).
+     * Partitions are equal-width in key space, so one much smaller than
+     * average covers a sparse range: its model has few segments at any
+     * epsilon, and one step tighter shortens the last-mile search for little
+     * memory. A much larger (dense) partition gets one step coarser, since its
+     * segment count grows with keys / epsilon. Key count says nothing about
+     * access frequency; hot ranges are handled by the hot cache and tiering.
+     */
+    size_t select_pgm_epsilon(size_t expert_keys, size_t avg_expert_keys) const {
+        static constexpr size_t kEpsilons[] = {16, 32, 64, 128, 256};
+        constexpr int kMaxStep = 4;
+
+        int step = static_cast<int>(std::lround(config_.compression_level * kMaxStep));
+        if (avg_expert_keys > 0) {
+            if (expert_keys * 2 < avg_expert_keys) {
+                --step;
+            } else if (expert_keys > avg_expert_keys * 2) {
+                ++step;
             }
         }
+        step = std::max(0, std::min(step, kMaxStep));
+        return kEpsilons[step];
+    }
+
+    /**
+     * @brief Instantiate the PGMExpert specialization matching epsilon
+     */
+    static std::unique_ptr<Expert> make_pgm_expert(size_t epsilon,
+                                                   const std::vector<KeyType>& k,
+                                                   const std::vector<ValueType>& v,
+                                                   KeyType min_k, KeyType max_k,
+                                                   Arena* arena) {
+        switch (epsilon) {
+            case 16:  return std::make_unique<PGMExpert<16>>(k, v, min_k, max_k, arena);
+            case 32:  return std::make_unique<PGMExpert<32>>(k, v, min_k, max_k, arena);
+            case 128: return std::make_unique<PGMExpert<128>>(k, v, min_k, max_k, arena);
+            case 256: return std::make_unique<PGMExpert<256>>(k, v, min_k, max_k, arena);
+            default:  return std::make_unique<PGMExpert<64>>(k, v, min_k, max_k, arena);
+        }
     }
 
     /**
@@ -608,4 +2409,26 @@ private:
     }
 };
 
+// Preset configurations (the compression level passed to the constructor
+// still tunes expert count, filter bits and PGM epsilon within a preset).
+// The runtime version switched the expert set at 0.3/0.7 but the delta buffer
+// at 0.5, so its balanced band used two buffers: HALIv2BalancedHash covers
+// [0.3, 0.5) and HALIv2Balanced covers [0.5, 0.7].
+template<typename KeyType, typename ValueType>
+using HALIv2Speed = HALIv2Index<KeyType, ValueType, HashDeltaBuffer, BloomFilterPolicy, SpeedExperts>;
+
+template<typename KeyType, typename ValueType>
+using HALIv2BalancedHash = HALIv2Index<KeyType, ValueType, HashDeltaBuffer, BloomFilterPolicy, BalancedExperts>;
+
+template<typename KeyType, typename ValueType>
+using HALIv2Balanced = HALIv2Index<KeyType, ValueType, ARTDeltaBuffer, BloomFilterPolicy, BalancedExperts>;
+
+template<typename KeyType, typename ValueType>
+using HALIv2Memory = HALIv2Index<KeyType, ValueType, ARTDeltaBuffer, BloomFilterPolicy, MemoryExperts>;
+
+// Speed preset without Bloom filters, for read paths dominated by hits where
+// the filters cost memory and hashing but never short-circuit
+template<typename KeyType, typename ValueType>
+using HALIv2SpeedNoFilter = HALIv2Index<KeyType, ValueType, HashDeltaBuffer, NoFilterPolicy, SpeedExperts>;
+
 } // namespace hali
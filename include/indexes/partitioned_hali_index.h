@@ -0,0 +1,421 @@
+#pragma once
+
+#include "index_interface.h"
+#include "indexes/haliv2_index.h"
+#include "spsc_queue.h"
+#include "workload_generator.h"
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <limits>
+#include <algorithm>
+
+namespace hali {
+
+/**
+ * @brief Shared-nothing, range-partitioned HALI for multi-core ingest
+ *
+ * The key space is split into disjoint ranges (equal-count quantiles of the
+ * loaded keys) and each range is owned by one HALIv2Index. A thin router maps
+ * a key to its partition with the same boundary binary search HALIv2 uses for
+ * experts.
+ *
+ * @tparam ShardIndex HALIv2 specialization owning each range (speed preset by default)
+ *
+ * Two ways to drive it:
+ * - Synchronous IndexInterface calls from a single thread (no workers running)
+ * - start()/submit()/wait_idle()/stop(): one worker thread per partition is the
+ *   only writer of its HALIv2Index; producers hand requests over lock-free SPSC
+ *   queues (one queue per producer/partition pair), so no locks or shared
+ *   cache lines are touched on the data path. Results come back through an
+ *   optional Completion per request. Workers, wait_idle() and producers
+ *   facing a full queue spin briefly and then sleep on a condition variable,
+ *   so an idle index does not burn a core per partition.
+ */
+template<typename KeyType, typename ValueType,
+         typename ShardIndex = HALIv2Speed<KeyType, ValueType>>
+class PartitionedHALIIndex : public IndexInterface<KeyType, ValueType> {
+public:
+    /**
+     * @brief Outcome of one submitted request, filled in by the owning worker
+     *
+     * Read it once done() is true, or after wait_idle() returns.
+     */
+    struct Completion {
+        std::optional<ValueType> value;  // FIND: the value found
+        bool hit = false;                // Key found, inserted or erased
+        std::atomic<bool> finished{false};
+
+        bool done() const { return finished.load(std::memory_order_acquire); }
+    };
+
+private:
+    struct Request {
+        OpType type;
+        KeyType key;
+        ValueType value;
+        Completion* completion;
+    };
+
+    struct Partition {
+        ShardIndex index;
+        std::vector<std::unique_ptr<SPSCQueue<Request>>> inboxes;  // One per producer
+        std::thread worker;
+        std::atomic<size_t> hits{0};  // Successful operations applied (written by the worker only)
+
+        // Parking: the worker sleeps on wake once its inboxes stay empty,
+        // wait_idle() on idle until they are, producers on space until a
+        // full inbox drains
+        std::mutex park_mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::condition_variable space;
+        std::atomic<bool> parked{false};
+        std::atomic<size_t> blocked_producers{0};
+
+        Partition(double compression_level, double merge_threshold)
+            : index(compression_level, merge_threshold) {}
+    };
+
+    // Requests drained from one inbox before moving to the next (fairness)
+    static constexpr size_t WORKER_BATCH = 64;
+    // Empty polls (worker) or failed checks (waiters) before sleeping
+    static constexpr size_t SPIN_LIMIT = 256;
+
+    size_t num_partitions_;
+    double compression_level_;
+    double merge_threshold_;
+
+    std::vector<std::unique_ptr<Partition>> partitions_;
+    std::vector<KeyType> boundaries_;  // boundaries_[i] = smallest key owned by partition i
+
+    std::atomic<bool> running_{false};
+
+public:
+    explicit PartitionedHALIIndex(size_t num_partitions = 4,
+                                  double compression_level = 0.25,
+                                  double merge_threshold = 0.005)
+        : num_partitions_(std::max(size_t(1), num_partitions)),
+          compression_level_(compression_level),
+          merge_threshold_(merge_threshold) {
+        reset_partitions();
+    }
+
+    ~PartitionedHALIIndex() override {
+        stop();
+    }
+
+    bool insert(const KeyType& key, const ValueType& value) override {
+        return partitions_[route(key)]->index.insert(key, value);
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const override {
+        return partitions_[route(key)]->index.find(key);
+    }
+
+    bool erase(const KeyType& key) override {
+        return partitions_[route(key)]->index.erase(key);
+    }
+
+    void load(const std::vector<KeyType>& keys,
+              const std::vector<ValueType>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values size mismatch");
+        }
+
+        stop();
+        reset_partitions();
+
+        std::vector<std::pair<KeyType, ValueType>> sorted_data;
+        sorted_data.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            sorted_data.push_back({keys[i], values[i]});
+        }
+        std::sort(sorted_data.begin(), sorted_data.end());
+
+        // Equal-count boundaries so every core owns the same share of keys
+        size_t n = sorted_data.size();
+        boundaries_.assign(num_partitions_, std::numeric_limits<KeyType>::min());
+        for (size_t p = 1; p < num_partitions_ && n > 0; ++p) {
+            boundaries_[p] = sorted_data[std::min(n - 1, p * n / num_partitions_)].first;
+        }
+
+        std::vector<std::vector<KeyType>> part_keys(num_partitions_);
+        std::vector<std::vector<ValueType>> part_values(num_partitions_);
+        for (const auto& kv : sorted_data) {
+            size_t p = route(kv.first);
+            part_keys[p].push_back(kv.first);
+            part_values[p].push_back(kv.second);
+        }
+
+        // Partitions are independent, so build them in parallel
+        std::vector<std::thread> builders;
+        for (size_t p = 0; p < num_partitions_; ++p) {
+            if (part_keys[p].empty()) continue;
+            builders.emplace_back([this, p, &part_keys, &part_values]() {
+                partitions_[p]->index.load(part_keys[p], part_values[p]);
+            });
+        }
+        for (auto& t : builders) {
+            t.join();
+        }
+    }
+
+    size_t size() const override {
+        size_t total = 0;
+        for (const auto& p : partitions_) {
+            total += p->index.size();
+        }
+        return total;
+    }
+
+    size_t memory_footprint() const override {
+        size_t total = boundaries_.capacity() * sizeof(KeyType);
+        for (const auto& p : partitions_) {
+            total += p->index.memory_footprint();
+        }
+        return total;
+    }
+
+    std::string name() const override {
+        return "PartitionedHALI(p=" + std::to_string(num_partitions_) + ")";
+    }
+
+    void clear() override {
+        stop();
+        reset_partitions();
+    }
+
+    /**
+     * @brief Spawn one owner thread per partition
+     * @param num_producers Number of client threads that will call submit()
+     * @param queue_capacity Capacity of each producer→partition queue
+     */
+    void start(size_t num_producers, size_t queue_capacity = 4096) {
+        stop();
+        for (auto& p : partitions_) {
+            p->inboxes.clear();
+            for (size_t i = 0; i < num_producers; ++i) {
+                p->inboxes.push_back(std::make_unique<SPSCQueue<Request>>(queue_capacity));
+            }
+            p->hits.store(0, std::memory_order_relaxed);
+        }
+
+        running_.store(true, std::memory_order_release);
+        for (auto& p : partitions_) {
+            Partition* part = p.get();
+            part->worker = std::thread([this, part]() { worker_loop(*part); });
+        }
+    }
+
+    /**
+     * @brief Hand an operation to its owning partition
+     * @param producer Caller's producer id in [0, num_producers); one thread per id
+     * @param completion Filled in once the request is applied (nullptr: result not needed);
+     *        must outlive the request
+     */
+    void submit(size_t producer, OpType type, const KeyType& key, const ValueType& value = ValueType(),
+                Completion* completion = nullptr) {
+        Partition& part = *partitions_[route(key)];
+        SPSCQueue<Request>& inbox = *part.inboxes[producer];
+        Request req{type, key, value, completion};
+        for (size_t spins = 0; !inbox.try_push(req); ++spins) {
+            if (spins < SPIN_LIMIT) {
+                std::this_thread::yield();  // Owner is behind; back off
+                continue;
+            }
+            // Sleep until the worker pops; it checks blocked_producers after each batch
+            std::unique_lock<std::mutex> lock(part.park_mutex);
+            part.blocked_producers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            part.space.wait(lock, [&]() { return inbox.try_push(req); });
+            part.blocked_producers.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+        wake_worker(part);
+    }
+
+    /**
+     * @brief Block until every submitted request has been applied
+     */
+    void wait_idle() const {
+        for (const auto& p : partitions_) {
+            Partition& part = *p;
+            for (size_t spins = 0; !inboxes_empty(part); ++spins) {
+                if (spins < SPIN_LIMIT) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // The worker notifies idle under park_mutex before it sleeps
+                std::unique_lock<std::mutex> lock(part.park_mutex);
+                part.idle.wait(lock, [&]() { return inboxes_empty(part); });
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Drain outstanding requests and join all owner threads
+     *
+     * Every request whose submit() returned before stop() was called is
+     * applied before its worker exits.
+     */
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        for (auto& p : partitions_) {
+            std::lock_guard<std::mutex> lock(p->park_mutex);
+            p->wake.notify_one();
+        }
+        for (auto& p : partitions_) {
+            if (p->worker.joinable()) {
+                p->worker.join();
+            }
+        }
+    }
+
+    /**
+     * @brief Successful operations applied by workers since start() (call when idle)
+     */
+    size_t completed_hits() const {
+        size_t total = 0;
+        for (const auto& p : partitions_) {
+            total += p->hits.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    size_t num_partitions() const { return num_partitions_; }
+
+private:
+    void reset_partitions() {
+        partitions_.clear();
+        for (size_t p = 0; p < num_partitions_; ++p) {
+            partitions_.push_back(std::make_unique<Partition>(compression_level_, merge_threshold_));
+        }
+        boundaries_.assign(num_partitions_, std::numeric_limits<KeyType>::min());
+    }
+
+    /**
+     * @brief Route key to the partition owning its range
+     */
+    size_t route(KeyType key) const {
+        auto it = std::upper_bound(boundaries_.begin(), boundaries_.end(), key);
+        return static_cast<size_t>(std::distance(boundaries_.begin(), it)) - 1;
+    }
+
+    void worker_loop(Partition& part) {
+        size_t idle_polls = 0;
+        while (true) {
+            if (drain_batch(part) > 0) {
+                idle_polls = 0;
+                continue;
+            }
+            if (!running_.load(std::memory_order_acquire)) {
+                // A push may have landed between the idle pass and this load.
+                // Pushes completed before stop() are visible after the acquire,
+                // so one more full drain applies all of them
+                while (drain_batch(part) > 0) {}
+                std::lock_guard<std::mutex> lock(part.park_mutex);
+                part.idle.notify_all();
+                break;
+            }
+            if (++idle_polls < SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            park(part);
+            idle_polls = 0;
+        }
+    }
+
+    /**
+     * @brief Sleep until a producer pushes or stop() is called
+     *
+     * parked is published before the inboxes are re-checked and producers
+     * check it after pushing (both behind seq_cst fences), so either the
+     * worker sees the new request or the producer sees parked and notifies.
+     */
+    void park(Partition& part) {
+        std::unique_lock<std::mutex> lock(part.park_mutex);
+        part.parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        part.idle.notify_all();
+        part.wake.wait(lock, [&]() {
+            return !inboxes_empty(part) || !running_.load(std::memory_order_acquire);
+        });
+        part.parked.store(false, std::memory_order_relaxed);
+    }
+
+    static void wake_worker(Partition& part) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (part.parked.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(part.park_mutex);
+            part.wake.notify_one();
+        }
+    }
+
+    static bool inboxes_empty(const Partition& part) {
+        for (const auto& inbox : part.inboxes) {
+            if (!inbox->empty()) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Apply up to WORKER_BATCH requests from each inbox
+     * @return Number of requests applied
+     */
+    static size_t drain_batch(Partition& part) {
+        size_t applied = 0;
+        for (auto& inbox : part.inboxes) {
+            for (size_t n = 0; n < WORKER_BATCH; ++n) {
+                const Request* req = inbox->front();
+                if (req == nullptr) break;
+                apply(part, *req);
+                inbox->pop();  // Pop after apply so empty() implies applied
+                applied++;
+            }
+        }
+        if (applied > 0) {
+            // Pairs with the seq_cst increment in submit(): a producer that
+            // is not counted yet will see the freed slots when it retries
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (part.blocked_producers.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(part.park_mutex);
+                part.space.notify_all();
+            }
+        }
+        return applied;
+    }
+
+    static void apply(Partition& part, const Request& req) {
+        bool hit = false;
+        std::optional<ValueType> value;
+        switch (req.type) {
+            case OpType::INSERT:
+                hit = part.index.insert(req.key, req.value);
+                break;
+            case OpType::FIND:
+                value = part.index.find(req.key);
+                hit = value.has_value();
+                break;
+            case OpType::ERASE:
+                hit = part.index.erase(req.key);
+                break;
+        }
+        part.hits.store(part.hits.load(std::memory_order_relaxed) + hit, std::memory_order_relaxed);
+        if (req.completion) {
+            req.completion->value = value;
+            req.completion->hit = hit;
+            req.completion->finished.store(true, std::memory_order_release);
+        }
+    }
+};
+
+} // namespace hali
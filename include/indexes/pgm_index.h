@@ -5,93 +5,101 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
 
 namespace hali {
 
 /**
  * @brief PGM-Index wrapper
  * Piecewise Geometric Model index with provable error bounds
- * Supports only static workloads (load once, query many times)
+ *
+ * Updatable through the logarithmic method (as in DynamicPGMIndex): data
+ * lives in levels of geometrically growing capacity, level i holding at
+ * most 2^(BUFFER_BITS + i) entries. Level 0 is a small sorted insert
+ * buffer; every other level is a static sorted array with its own PGM model.
+ * When the buffer fills, it and the levels below the first one with room
+ * for all of them are merged into that level, so each entry is rewritten
+ * O(log n) times: O(log n) amortized per update.
+ *
+ * Erase writes a tombstone entry. Newer levels shadow older ones, so a
+ * lookup probes levels from the buffer down and stops at the first entry
+ * for the key. Tombstones are dropped when they are merged into the
+ * deepest level, where no older entry can remain.
+ *
+ * @tparam Epsilon PGM error bound; smaller = narrower last-mile search, more segments
  */
-template<typename KeyType, typename ValueType>
+template<typename KeyType, typename ValueType, size_t Epsilon = 64>
 class PGMIndex : public IndexInterface<KeyType, ValueType> {
 private:
     static_assert(std::is_integral<KeyType>::value,
                   "PGMIndex requires integral key type");
 
-    // PGM index for position prediction
-    pgm::PGMIndex<KeyType, 64> pgm_; // error bound of 64
+    static constexpr size_t BUFFER_BITS = 7;        // Level 0 holds 128 entries
+    static constexpr size_t MIN_MODEL_KEYS = 4096;  // Smaller levels use binary search
 
-    // Sorted arrays for actual data storage
-    std::vector<KeyType> keys_;
-    std::vector<ValueType> values_;
+    struct Level {
+        std::vector<KeyType> keys;
+        std::vector<ValueType> values;
+        std::vector<bool> tombstones;
 
-    // Dynamic buffer for inserts (not natively supported by PGM)
-    std::vector<std::pair<KeyType, ValueType>> insert_buffer_;
+        // PGM index for position prediction (levels of MIN_MODEL_KEYS+ entries)
+        pgm::PGMIndex<KeyType, Epsilon> pgm;
+        bool has_model = false;
 
-public:
-    PGMIndex() = default;
+        size_t size() const { return keys.size(); }
+        bool empty() const { return keys.empty(); }
 
-    bool insert(const KeyType& key, const ValueType& value) override {
-        // PGM doesn't support efficient inserts, so buffer them
-        // Check if key already exists in main index
-        if (!keys_.empty()) {
-            auto range = pgm_.search(key);
-            auto it = std::lower_bound(keys_.begin() + range.lo,
-                                      keys_.begin() + range.hi,
-                                      key);
-            if (it != keys_.begin() + range.hi && *it == key) {
-                return false; // Key already exists
-            }
+        void clear() {
+            keys.clear();
+            values.clear();
+            tombstones.clear();
+            pgm = pgm::PGMIndex<KeyType, Epsilon>();
+            has_model = false;
         }
 
-        // Check insert buffer
-        for (const auto& p : insert_buffer_) {
-            if (p.first == key) {
-                return false; // Key already in buffer
-            }
+        void build_model() {
+            has_model = keys.size() >= MIN_MODEL_KEYS;
+            pgm = has_model ? pgm::PGMIndex<KeyType, Epsilon>(keys.begin(), keys.end())
+                            : pgm::PGMIndex<KeyType, Epsilon>();
         }
+    };
 
-        insert_buffer_.push_back({key, value});
+    // levels_[0] is the insert buffer; higher levels are older and larger
+    std::vector<Level> levels_;
+    size_t size_ = 0;
+    size_t num_merges_ = 0;
+
+public:
+    PGMIndex() : levels_(1) {}
+
+    bool insert(const KeyType& key, const ValueType& value) override {
+        size_t level, pos;
+        if (locate(key, level, pos) && !levels_[level].tombstones[pos]) {
+            return false; // Key already exists
+        }
+
+        put(key, value, false);
+        size_++;
         return true;
     }
 
     std::optional<ValueType> find(const KeyType& key) const override {
-        // Search main index first
-        if (!keys_.empty()) {
-            auto range = pgm_.search(key);
-            auto it = std::lower_bound(keys_.begin() + range.lo,
-                                      keys_.begin() + range.hi,
-                                      key);
-
-            if (it != keys_.begin() + range.hi && *it == key) {
-                size_t idx = std::distance(keys_.begin(), it);
-                return values_[idx];
-            }
+        size_t level, pos;
+        if (!locate(key, level, pos) || levels_[level].tombstones[pos]) {
+            return std::nullopt;
         }
-
-        // Search insert buffer
-        for (const auto& p : insert_buffer_) {
-            if (p.first == key) {
-                return p.second;
-            }
-        }
-
-        return std::nullopt;
+        return levels_[level].values[pos];
     }
 
     bool erase(const KeyType& key) override {
-        // Erasing from a learned index is expensive - not optimized
-        // Remove from buffer if exists
-        for (auto it = insert_buffer_.begin(); it != insert_buffer_.end(); ++it) {
-            if (it->first == key) {
-                insert_buffer_.erase(it);
-                return true;
-            }
+        size_t level, pos;
+        if (!locate(key, level, pos) || levels_[level].tombstones[pos]) {
+            return false;
         }
 
-        // Removing from main index requires rebuild - not implemented efficiently
-        return false;
+        put(key, ValueType{}, true);
+        size_--;
+        return true;
     }
 
     void load(const std::vector<KeyType>& keys,
@@ -100,65 +108,198 @@ public:
             throw std::invalid_argument("Keys and values size mismatch");
         }
 
-        // Copy and ensure sorted
-        keys_ = keys;
-        values_ = values;
-
         // Sort by keys
-        std::vector<size_t> indices(keys_.size());
+        std::vector<size_t> indices(keys.size());
         std::iota(indices.begin(), indices.end(), 0);
         std::sort(indices.begin(), indices.end(),
-                  [this](size_t a, size_t b) { return keys_[a] < keys_[b]; });
+                  [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
 
-        std::vector<KeyType> sorted_keys(keys_.size());
-        std::vector<ValueType> sorted_values(values_.size());
+        // Bulk-loaded data goes straight into the first level large enough for it
+        size_t target = 1;
+        while (level_capacity(target) < keys.size()) {
+            target++;
+        }
+        levels_.assign(target + 1, Level());
 
+        Level& level = levels_[target];
+        level.keys.resize(keys.size());
+        level.values.resize(values.size());
         for (size_t i = 0; i < indices.size(); ++i) {
-            sorted_keys[i] = keys_[indices[i]];
-            sorted_values[i] = values_[indices[i]];
+            level.keys[i] = keys[indices[i]];
+            level.values[i] = values[indices[i]];
         }
+        level.tombstones.assign(keys.size(), false);
+        level.build_model();
 
-        keys_ = std::move(sorted_keys);
-        values_ = std::move(sorted_values);
-
-        // Build PGM index
-        pgm_ = pgm::PGMIndex<KeyType, 64>(keys_.begin(), keys_.end());
-
-        // Clear any pending inserts
-        insert_buffer_.clear();
+        size_ = keys.size();
+        num_merges_ = 0;
     }
 
     size_t size() const override {
-        return keys_.size() + insert_buffer_.size();
+        return size_;
     }
 
     size_t memory_footprint() const override {
-        // Keys and values arrays
-        size_t data_size = keys_.capacity() * sizeof(KeyType) +
-                          values_.capacity() * sizeof(ValueType);
+        size_t total = levels_.capacity() * sizeof(Level);
+        for (const auto& level : levels_) {
+            // Keys and values arrays, one bit per entry for tombstones
+            total += level.keys.capacity() * sizeof(KeyType) +
+                     level.values.capacity() * sizeof(ValueType) +
+                     level.tombstones.capacity() / 8;
+
+            // PGM segments (reported by the model itself, grows as Epsilon shrinks)
+            if (level.has_model) {
+                total += level.pgm.size_in_bytes();
+            }
+        }
+        return total;
+    }
+
+    std::string name() const override {
+        if (Epsilon == 64) {
+            return "PGM-Index";
+        }
+        return "PGM-Index(eps=" + std::to_string(Epsilon) + ")";
+    }
 
-        // PGM segments (very compact - typically ~10-20 bytes per segment)
-        // Number of segments = data_size / segment_size
-        // With error=64, typically one segment per ~1000-10000 keys
-        size_t num_segments = std::max(size_t(1), keys_.size() / 5000);
-        size_t pgm_size = num_segments * 20; // approx 20 bytes per segment
+    void clear() override {
+        levels_.assign(1, Level());
+        size_ = 0;
+        num_merges_ = 0;
+    }
+
+    /**
+     * @brief Number of non-empty levels, insert buffer included
+     */
+    size_t num_levels() const {
+        return std::count_if(levels_.begin(), levels_.end(),
+                             [](const Level& level) { return !level.empty(); });
+    }
 
-        // Insert buffer
-        size_t buffer_size = insert_buffer_.capacity() *
-                            (sizeof(KeyType) + sizeof(ValueType));
+    /**
+     * @brief Number of level merges since the last load()
+     */
+    size_t num_merges() const { return num_merges_; }
 
-        return data_size + pgm_size + buffer_size;
+private:
+    static size_t level_capacity(size_t level) {
+        return size_t(1) << (BUFFER_BITS + level);
     }
 
-    std::string name() const override {
-        return "PGM-Index";
+    /**
+     * @brief Newest entry for key (value or tombstone)
+     * @return false if no level holds key
+     */
+    bool locate(const KeyType& key, size_t& level, size_t& pos) const {
+        for (level = 0; level < levels_.size(); ++level) {
+            const Level& l = levels_[level];
+            if (l.empty()) continue;
+
+            auto lo = l.keys.begin();
+            auto hi = l.keys.end();
+            if (l.has_model) {
+                auto range = l.pgm.search(key);
+                lo = l.keys.begin() + range.lo;
+                hi = l.keys.begin() + range.hi;
+            }
+            auto it = std::lower_bound(lo, hi, key);
+            if (it != hi && *it == key) {
+                pos = static_cast<size_t>(std::distance(l.keys.begin(), it));
+                return true;
+            }
+        }
+        return false;
     }
 
-    void clear() override {
-        keys_.clear();
-        values_.clear();
-        insert_buffer_.clear();
-        pgm_ = pgm::PGMIndex<KeyType, 64>();
+    /**
+     * @brief Write an entry into the insert buffer, flushing it when full
+     */
+    void put(const KeyType& key, const ValueType& value, bool tombstone) {
+        Level& buffer = levels_[0];
+        auto it = std::lower_bound(buffer.keys.begin(), buffer.keys.end(), key);
+        size_t pos = static_cast<size_t>(std::distance(buffer.keys.begin(), it));
+
+        if (it != buffer.keys.end() && *it == key) {
+            buffer.values[pos] = value;
+            buffer.tombstones[pos] = tombstone;
+            return;
+        }
+
+        buffer.keys.insert(it, key);
+        buffer.values.insert(buffer.values.begin() + pos, value);
+        buffer.tombstones.insert(buffer.tombstones.begin() + pos, tombstone);
+        if (buffer.size() >= level_capacity(0)) {
+            flush_buffer();
+        }
+    }
+
+    /**
+     * @brief Merge the buffer and the levels below the first level with room for them
+     */
+    void flush_buffer() {
+        // Smallest target level whose capacity covers it and every newer level
+        size_t total = levels_[0].size();
+        size_t target = 1;
+        for (;; ++target) {
+            if (target == levels_.size()) {
+                levels_.emplace_back();
+            }
+            total += levels_[target].size();
+            if (total <= level_capacity(target)) {
+                break;
+            }
+        }
+
+        bool deepest = true;
+        for (size_t i = target + 1; i < levels_.size(); ++i) {
+            if (!levels_[i].empty()) {
+                deepest = false;
+                break;
+            }
+        }
+
+        // Fold newest to oldest; tombstones only vanish when nothing older is left
+        Level merged = std::move(levels_[0]);
+        for (size_t i = 1; i <= target; ++i) {
+            merged = merge_levels(merged, levels_[i], deepest && i == target);
+            levels_[i].clear();
+        }
+        levels_[0].clear();
+
+        merged.build_model();
+        levels_[target] = std::move(merged);
+        num_merges_++;
+    }
+
+    /**
+     * @brief Merge two sorted levels; newer wins on equal keys
+     */
+    static Level merge_levels(const Level& newer, const Level& older, bool drop_tombstones) {
+        Level out;
+        out.keys.reserve(newer.size() + older.size());
+        out.values.reserve(newer.size() + older.size());
+        out.tombstones.reserve(newer.size() + older.size());
+
+        auto emit = [&](const Level& src, size_t i) {
+            if (drop_tombstones && src.tombstones[i]) return;
+            out.keys.push_back(src.keys[i]);
+            out.values.push_back(src.values[i]);
+            out.tombstones.push_back(src.tombstones[i]);
+        };
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < newer.size() || j < older.size()) {
+            if (j == older.size() || (i < newer.size() && newer.keys[i] < older.keys[j])) {
+                emit(newer, i++);
+            } else if (i == newer.size() || older.keys[j] < newer.keys[i]) {
+                emit(older, j++);
+            } else {
+                emit(newer, i++);  // Shadows the older entry
+                j++;
+            }
+        }
+        return out;
     }
 };
 
@@ -0,0 +1,342 @@
+#pragma once
+
+#include "index_interface.h"
+#include "bounded_delta_buffer.h"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+
+namespace hali {
+
+/**
+ * @brief RadixSpline: error-bounded linear spline with a radix table over it
+ * Kipf et al., "RadixSpline: A Single-Pass Learned Index" (aiDM 2020)
+ *
+ * One pass over the sorted keys fits a spline with a greedy shrinking
+ * corridor: every key's position is interpolated from the two spline points
+ * around it to within max_error. A table indexed by the top radix_bits bits
+ * of (key - min_key) maps each prefix to the first spline point with that
+ * prefix, so a lookup searches only the few spline points of one prefix,
+ * interpolates, and finishes with a binary search of 2 * max_error + 1 keys.
+ *
+ * Updates go to a bounded hashed delta buffer (as in RMIIndex), merged into
+ * the sorted arrays and rebuilt in one pass when it fills.
+ */
+template<typename KeyType, typename ValueType>
+class RadixSplineIndex : public IndexInterface<KeyType, ValueType> {
+private:
+    static_assert(std::is_integral<KeyType>::value,
+                  "RadixSplineIndex requires integral key type");
+
+    using U = typename std::make_unsigned<KeyType>::type;
+
+    struct SplinePoint {
+        KeyType key;
+        double pos;
+    };
+
+    static constexpr size_t LINEAR_SEGMENT_SEARCH = 32;  // Fewer points: scan linearly
+
+    // Tuning knobs
+    size_t max_error_;
+    size_t radix_bits_;
+
+    // Model
+    std::vector<SplinePoint> spline_;
+    std::vector<uint32_t> radix_table_;  // Prefix -> first spline point with that prefix
+    KeyType min_key_ = KeyType();
+    unsigned shift_ = 0;
+
+    // Sorted data
+    std::vector<KeyType> keys_;
+    std::vector<ValueType> values_;
+
+    // Updates since the last build
+    BoundedDeltaBuffer<KeyType, ValueType> buffer_;
+    size_t size_ = 0;
+
+public:
+    /**
+     * @param max_error Spline error bound in positions
+     * @param radix_bits Bits of the key prefix indexing the radix table
+     */
+    explicit RadixSplineIndex(size_t max_error = 32, size_t radix_bits = 18)
+        : max_error_(max_error), radix_bits_(radix_bits) {
+        if (radix_bits_ == 0 || radix_bits_ > 30) {
+            throw std::invalid_argument("RadixSplineIndex radix_bits must be in [1, 30]");
+        }
+    }
+
+    bool insert(const KeyType& key, const ValueType& value) override {
+        if (const auto* entry = buffer_.lookup(key)) {
+            if (entry->has_value()) {
+                return false;
+            }
+            // Re-insert of an erased key: the value overrides the base entry
+        } else if (base_position(key).has_value()) {
+            return false;
+        }
+
+        buffer_.put(key, value);
+        size_++;
+        if (buffer_.full()) {
+            merge_buffer();
+        }
+        return true;
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const override {
+        // Buffered entries (values and tombstones) shadow the base array
+        if (!buffer_.empty()) {
+            if (const auto* entry = buffer_.lookup(key)) {
+                return *entry;
+            }
+        }
+
+        if (auto idx = base_position(key)) {
+            return values_[*idx];
+        }
+        return std::nullopt;
+    }
+
+    bool erase(const KeyType& key) override {
+        if (const auto* entry = buffer_.lookup(key)) {
+            if (!entry->has_value()) {
+                return false;
+            }
+            if (base_position(key).has_value()) {
+                buffer_.put_tombstone(key);
+            } else {
+                buffer_.remove(key);
+            }
+        } else if (base_position(key).has_value()) {
+            buffer_.put_tombstone(key);
+        } else {
+            return false;
+        }
+
+        size_--;
+        if (buffer_.full()) {
+            merge_buffer();
+        }
+        return true;
+    }
+
+    void load(const std::vector<KeyType>& keys,
+              const std::vector<ValueType>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values size mismatch");
+        }
+
+        // Sort by keys
+        std::vector<size_t> indices(keys.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::sort(indices.begin(), indices.end(),
+                  [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+        keys_.resize(keys.size());
+        values_.resize(values.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            keys_[i] = keys[indices[i]];
+            values_[i] = values[indices[i]];
+        }
+
+        build();
+
+        buffer_.reset(keys_.size());
+        size_ = keys_.size();
+    }
+
+    size_t size() const override {
+        return size_;
+    }
+
+    size_t memory_footprint() const override {
+        size_t data_size = keys_.capacity() * sizeof(KeyType) +
+                           values_.capacity() * sizeof(ValueType);
+        return data_size + model_bytes() + buffer_.memory_footprint();
+    }
+
+    std::string name() const override {
+        if (max_error_ == 32 && radix_bits_ == 18) {
+            return "RadixSpline";
+        }
+        return "RadixSpline(err=" + std::to_string(max_error_) +
+               ",bits=" + std::to_string(radix_bits_) + ")";
+    }
+
+    void clear() override {
+        keys_.clear();
+        values_.clear();
+        spline_.clear();
+        radix_table_.clear();
+        buffer_.reset(0);
+        size_ = 0;
+    }
+
+    size_t num_spline_points() const { return spline_.size(); }
+
+    /**
+     * @brief Bytes of the spline and radix table
+     */
+    size_t model_bytes() const {
+        return spline_.capacity() * sizeof(SplinePoint) +
+               radix_table_.capacity() * sizeof(uint32_t);
+    }
+
+    const BoundedDeltaBuffer<KeyType, ValueType>& delta_buffer() const { return buffer_; }
+
+private:
+    /**
+     * @brief Fit the spline and fill the radix table in one pass over keys_
+     */
+    void build() {
+        spline_.clear();
+        radix_table_.clear();
+        if (keys_.empty()) return;
+
+        min_key_ = keys_.front();
+        U range = key_distance(min_key_, keys_.back());
+        unsigned range_bits = 0;
+        while (range_bits < sizeof(U) * 8 && (range >> range_bits) != 0) {
+            range_bits++;
+        }
+        unsigned table_bits = std::min(range_bits, static_cast<unsigned>(radix_bits_));
+        shift_ = range_bits - table_bits;
+        radix_table_.assign((size_t(1) << table_bits) + 2, 0);
+
+        // Greedy spline corridor: the next spline point must lie between the
+        // lines from the last spline point to the tightest upper and lower limits
+        double error = static_cast<double>(max_error_);
+        SplinePoint upper{}, lower{}, prev{};
+        size_t prev_prefix = 0;
+
+        auto add_spline_point = [&](const SplinePoint& point) {
+            size_t prefix = prefix_of(point.key);
+            for (size_t p = prev_prefix + 1; p <= prefix; ++p) {
+                radix_table_[p] = static_cast<uint32_t>(spline_.size());
+            }
+            prev_prefix = std::max(prev_prefix, prefix);
+            spline_.push_back(point);
+        };
+
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (i > 0 && keys_[i] == keys_[i - 1]) continue;  // Duplicates map to the first
+            SplinePoint point{keys_[i], static_cast<double>(i)};
+
+            if (spline_.empty()) {
+                add_spline_point(point);
+                prev = point;
+                continue;
+            }
+
+            SplinePoint upper_limit{point.key, point.pos + error};
+            SplinePoint lower_limit{point.key, std::max(0.0, point.pos - error)};
+            if (prev.key == spline_.back().key) {
+                // First key after a spline point sets the corridor
+                upper = upper_limit;
+                lower = lower_limit;
+                prev = point;
+                continue;
+            }
+
+            const SplinePoint& last = spline_.back();
+            if (!below_line(last, upper, point) || !above_line(last, lower, point)) {
+                // Point leaves the corridor: the previous key becomes a spline point
+                add_spline_point(prev);
+                upper = upper_limit;
+                lower = lower_limit;
+            } else {
+                if (below_line(last, upper, upper_limit)) upper = upper_limit;
+                if (above_line(last, lower, lower_limit)) lower = lower_limit;
+            }
+            prev = point;
+        }
+        if (spline_.back().key != prev.key) {
+            add_spline_point(prev);
+        }
+
+        for (size_t p = prev_prefix + 1; p < radix_table_.size(); ++p) {
+            radix_table_[p] = static_cast<uint32_t>(spline_.size());
+        }
+        spline_.shrink_to_fit();
+    }
+
+    // Slope of origin->p strictly below / above slope of origin->limit (p right of origin)
+    static bool below_line(const SplinePoint& origin, const SplinePoint& limit, const SplinePoint& p) {
+        double limit_dx = static_cast<double>(key_distance(origin.key, limit.key));
+        double p_dx = static_cast<double>(key_distance(origin.key, p.key));
+        return (p.pos - origin.pos) * limit_dx < (limit.pos - origin.pos) * p_dx;
+    }
+
+    static bool above_line(const SplinePoint& origin, const SplinePoint& limit, const SplinePoint& p) {
+        double limit_dx = static_cast<double>(key_distance(origin.key, limit.key));
+        double p_dx = static_cast<double>(key_distance(origin.key, p.key));
+        return (p.pos - origin.pos) * limit_dx > (limit.pos - origin.pos) * p_dx;
+    }
+
+    // to - from without signed overflow (from <= to)
+    static U key_distance(KeyType from, KeyType to) {
+        return static_cast<U>(static_cast<U>(to) - static_cast<U>(from));
+    }
+
+    size_t prefix_of(KeyType key) const {
+        return static_cast<size_t>(key_distance(min_key_, key) >> shift_);
+    }
+
+    /**
+     * @brief Interpolated position of key (min_key_ <= key <= last key)
+     */
+    double estimate(KeyType key) const {
+        size_t prefix = prefix_of(key);
+        size_t begin = radix_table_[prefix];
+        size_t end = std::min<size_t>(radix_table_[prefix + 1] + 1, spline_.size());
+
+        // First spline point >= key; the segment ends there
+        auto less = [](const SplinePoint& point, KeyType k) { return point.key < k; };
+        auto it = spline_.begin() + begin;
+        if (end - begin < LINEAR_SEGMENT_SEARCH) {
+            while (it != spline_.begin() + end && it->key < key) ++it;
+        } else {
+            it = std::lower_bound(spline_.begin() + begin, spline_.begin() + end, key, less);
+        }
+        if (it == spline_.end()) return spline_.back().pos;
+        if (it->key == key || it == spline_.begin()) return it->pos;
+
+        const SplinePoint& down = *(it - 1);
+        const SplinePoint& up = *it;
+        double dx = static_cast<double>(key_distance(down.key, up.key));
+        double offset = static_cast<double>(key_distance(down.key, key));
+        return down.pos + offset * (up.pos - down.pos) / dx;
+    }
+
+    /**
+     * @brief Position of key in keys_, if present
+     */
+    std::optional<size_t> base_position(const KeyType& key) const {
+        if (keys_.empty() || key < keys_.front() || key > keys_.back()) return std::nullopt;
+
+        // One position of slack each side for rounding of the interpolation
+        size_t pos = static_cast<size_t>(estimate(key));
+        size_t lo = pos > max_error_ + 1 ? pos - max_error_ - 1 : 0;
+        size_t hi = std::min(keys_.size(), pos + max_error_ + 2);
+        auto it = std::lower_bound(keys_.begin() + lo, keys_.begin() + hi, key);
+        if (it != keys_.begin() + hi && *it == key) {
+            return static_cast<size_t>(std::distance(keys_.begin(), it));
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Fold the buffer into keys_/values_ and rebuild the spline
+     */
+    void merge_buffer() {
+        buffer_.merge_into(keys_, values_);
+        build();
+    }
+};
+
+} // namespace hali
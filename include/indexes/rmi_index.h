@@ -1,17 +1,124 @@
 #pragma once
 
 #include "index_interface.h"
+#include "search_utils.h"
+#include "timing_utils.h"
+#include "bounded_delta_buffer.h"
 #include <vector>
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+#include <string>
+#include <limits>
+#include <random>
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include <type_traits>
+#include <cstdint>
 
 namespace hali {
 
+/**
+ * @brief Layer-1 model family of an RMI
+ */
+enum class RMIRootType {
+    LINEAR,         // Least-squares line over all keys
+    CUBIC,          // Least-squares cubic over the normalized key range
+    LINEAR_SPLINE,  // Line through the first and last key
+    RADIX           // Top bits of (key - min_key)
+};
+
+inline std::string rmi_root_type_name(RMIRootType type) {
+    switch (type) {
+        case RMIRootType::LINEAR: return "linear";
+        case RMIRootType::CUBIC: return "cubic";
+        case RMIRootType::LINEAR_SPLINE: return "linear_spline";
+        case RMIRootType::RADIX: return "radix";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief RMI topology: root model family and number of linear leaves
+ */
+struct RMIConfig {
+    RMIRootType root_type = RMIRootType::LINEAR;
+    size_t branching_factor = 100;
+
+    std::string to_string() const {
+        return rmi_root_type_name(root_type) + "," + std::to_string(branching_factor);
+    }
+
+    /**
+     * @brief Inverse of to_string(), e.g. "linear_spline,4096"
+     */
+    static RMIConfig from_string(const std::string& text) {
+        size_t comma = text.find(',');
+        if (comma == std::string::npos) {
+            throw std::invalid_argument("RMI config must be <root>,<branching>: " + text);
+        }
+        RMIConfig config;
+        std::string root = text.substr(0, comma);
+        const RMIRootType types[] = {RMIRootType::LINEAR, RMIRootType::CUBIC,
+                                     RMIRootType::LINEAR_SPLINE, RMIRootType::RADIX};
+        bool known = false;
+        for (RMIRootType type : types) {
+            if (rmi_root_type_name(type) == root) {
+                config.root_type = type;
+                known = true;
+            }
+        }
+        if (!known) {
+            throw std::invalid_argument("Unknown RMI root type: " + root);
+        }
+        config.branching_factor = std::stoull(text.substr(comma + 1));
+        if (config.branching_factor == 0) {
+            throw std::invalid_argument("RMI branching factor must be positive: " + text);
+        }
+        return config;
+    }
+};
+
+/**
+ * @brief One topology evaluated by RMIIndex::explore_configs()
+ */
+struct RMICandidate {
+    RMIConfig config;
+    size_t model_bytes = 0;       // Root + leaves
+    double avg_log2_error = 0.0;  // Mean log2 of the per-key search window (lookup cost proxy)
+    bool pareto = false;          // No other candidate is both smaller and more accurate
+    double lookup_ns = 0.0;       // Measured on the sample (Pareto candidates only)
+};
+
+/**
+ * @brief Order-sensitive fingerprint of a sorted key array
+ *
+ * Ties a code-generated RMI (see RMIIndex::emit_header()) to the exact keys
+ * it was trained on.
+ */
+template<typename KeyType>
+uint64_t rmi_key_fingerprint(const std::vector<KeyType>& sorted_keys) {
+    uint64_t h = 0xcbf29ce484222325ULL ^ sorted_keys.size();
+    for (KeyType key : sorted_keys) {
+        h = (h ^ static_cast<uint64_t>(key)) * 0x100000001b3ULL;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
 /**
  * @brief Simple 2-layer Recursive Model Index (RMI)
- * Layer 1: Single linear model that routes to Layer 2
+ * Layer 1: Root model (linear, cubic, linear spline or radix) that routes to Layer 2
  * Layer 2: Multiple linear models for final position prediction
+ *
+ * The topology is fixed by an RMIConfig; optimize() picks one for a dataset
+ * in the spirit of CDFShop: candidates are trained on a sample, the Pareto
+ * front of model size against average log2 search window is kept, and the
+ * front is timed to pick the fastest configuration within a size budget.
  */
 template<typename KeyType, typename ValueType>
 class RMIIndex : public IndexInterface<KeyType, ValueType> {
@@ -26,31 +133,36 @@ private:
         double slope = 0.0;
         double intercept = 0.0;
 
+        // Measured (true - predicted) position error over the training keys
+        int64_t min_error = 0;
+        int64_t max_error = 0;
+        bool bounded = false;  // false until record_errors() has seen a key
+
         /**
          * @brief Train linear model on sorted data
+         * @param keys First of n sorted keys
+         * @param position Maps a key's index in [0, n) to its target position
          */
-        void train(const std::vector<KeyType>& keys,
-                  const std::vector<size_t>& positions) {
-            if (keys.empty()) return;
-
-            size_t n = keys.size();
-            double sum_x = 0, sum_y = 0, sum_xy = 0, sum_x2 = 0;
+        template<typename PositionFn>
+        void train(const KeyType* keys, size_t n, PositionFn position) {
+            if (n == 0) return;
 
+            double sum_x = 0, sum_y = 0;
             for (size_t i = 0; i < n; ++i) {
-                double x = static_cast<double>(keys[i]);
-                double y = static_cast<double>(positions[i]);
-
-                sum_x += x;
-                sum_y += y;
-                sum_xy += x * y;
-                sum_x2 += x * x;
+                sum_x += static_cast<double>(keys[i]);
+                sum_y += static_cast<double>(position(i));
             }
-
             double mean_x = sum_x / n;
             double mean_y = sum_y / n;
 
-            double numerator = sum_xy - n * mean_x * mean_y;
-            double denominator = sum_x2 - n * mean_x * mean_x;
+            // Centered sums: the raw-moment form cancels catastrophically
+            // for 64-bit keys
+            double numerator = 0, denominator = 0;
+            for (size_t i = 0; i < n; ++i) {
+                double dx = static_cast<double>(keys[i]) - mean_x;
+                numerator += dx * (static_cast<double>(position(i)) - mean_y);
+                denominator += dx * dx;
+            }
 
             if (std::abs(denominator) > 1e-10) {
                 slope = numerator / denominator;
@@ -69,55 +181,257 @@ private:
             pred = std::max(0.0, std::min(pred, static_cast<double>(max_pos)));
             return static_cast<size_t>(pred);
         }
+
+        /**
+         * @brief Record the exact error window of this model on its keys
+         */
+        template<typename PositionFn>
+        void record_errors(const KeyType* keys, size_t n, PositionFn position,
+                           size_t max_pos) {
+            if (n == 0) return;
+
+            min_error = 0;
+            max_error = 0;
+            for (size_t i = 0; i < n; ++i) {
+                int64_t err = static_cast<int64_t>(position(i)) -
+                              static_cast<int64_t>(predict(keys[i], max_pos));
+                min_error = std::min(min_error, err);
+                max_error = std::max(max_error, err);
+            }
+            bounded = true;
+        }
+    };
+
+    /**
+     * @brief Layer-1 model mapping a key to a leaf
+     *
+     * Every family is non-decreasing in the key, so leaves own contiguous
+     * runs of the sorted keys.
+     */
+    struct RootModel {
+        RMIRootType type = RMIRootType::LINEAR;
+        LinearModel linear;           // LINEAR, LINEAR_SPLINE
+        double coef[4] = {0, 0, 0, 0}; // CUBIC: c0 + c1*t + c2*t^2 + c3*t^3
+        KeyType min_key = 0;
+        double inv_range = 0.0;       // CUBIC: t = (key - min_key) * inv_range, clamped to [0, 1]
+        unsigned shift = 0;           // RADIX
+
+        size_t predict(KeyType key, size_t max_leaf) const {
+            switch (type) {
+                case RMIRootType::CUBIC: {
+                    double t = key <= min_key ? 0.0
+                             : std::min(1.0, static_cast<double>(key - min_key) * inv_range);
+                    double pred = ((coef[3] * t + coef[2]) * t + coef[1]) * t + coef[0];
+                    pred = std::max(0.0, std::min(pred, static_cast<double>(max_leaf)));
+                    return static_cast<size_t>(pred);
+                }
+                case RMIRootType::RADIX: {
+                    if (key <= min_key) return 0;
+                    uint64_t offset = static_cast<uint64_t>(key - min_key);
+                    return std::min(static_cast<size_t>(shift >= 64 ? 0 : offset >> shift), max_leaf);
+                }
+                default:
+                    return linear.predict(key, max_leaf);
+            }
+        }
+
+        /**
+         * @brief Fit the root to map n sorted keys onto num_leaves leaves
+         */
+        void train(RMIRootType root_type, const KeyType* keys, size_t n, size_t num_leaves) {
+            *this = RootModel();
+            type = root_type;
+            if (n == 0) return;
+
+            min_key = keys[0];
+            KeyType max_key = keys[n - 1];
+            double leaves = static_cast<double>(num_leaves);
+
+            switch (type) {
+                case RMIRootType::LINEAR:
+                    linear.train(keys, n, [n, num_leaves](size_t i) { return (i * num_leaves) / n; });
+                    if (linear.slope < 0.0) {
+                        // Only rounding can get here; a flat root is still monotone
+                        linear.slope = 0.0;
+                        linear.intercept = 0.0;
+                    }
+                    break;
+
+                case RMIRootType::LINEAR_SPLINE:
+                    if (max_key > min_key) {
+                        linear.slope = leaves / static_cast<double>(max_key - min_key);
+                        linear.intercept = -linear.slope * static_cast<double>(min_key);
+                    }
+                    break;
+
+                case RMIRootType::CUBIC:
+                    if (max_key > min_key) {
+                        inv_range = 1.0 / static_cast<double>(max_key - min_key);
+                        fit_cubic(keys, n, leaves);
+                    }
+                    break;
+
+                case RMIRootType::RADIX: {
+                    uint64_t range = static_cast<uint64_t>(max_key - min_key);
+                    unsigned range_bits = 0;
+                    while (range_bits < 64 && (range >> range_bits) != 0) {
+                        range_bits++;
+                    }
+                    unsigned leaf_bits = 0;
+                    while ((size_t(2) << leaf_bits) <= num_leaves && leaf_bits < 63) {
+                        leaf_bits++;
+                    }
+                    shift = range_bits > leaf_bits ? range_bits - leaf_bits : 0;
+                    break;
+                }
+            }
+        }
+
+    private:
+        // Cubic fits use at most this many evenly spaced keys
+        static constexpr size_t CUBIC_FIT_POINTS = 1 << 16;
+
+        /**
+         * @brief Least-squares cubic in t; falls back to the spline if not monotone on [0, 1]
+         */
+        void fit_cubic(const KeyType* keys, size_t n, double leaves) {
+            size_t stride = std::max(size_t(1), n / CUBIC_FIT_POINTS);
+
+            // Normal equations A c = b with A[r][c] = sum t^(r+c), b[r] = sum y t^r
+            double a[4][5] = {};
+            for (size_t i = 0; i < n; i += stride) {
+                double t = static_cast<double>(keys[i] - min_key) * inv_range;
+                double y = static_cast<double>(i) * leaves / n;
+                double powers[7] = {1.0};
+                for (int k = 1; k < 7; ++k) powers[k] = powers[k - 1] * t;
+                for (int r = 0; r < 4; ++r) {
+                    for (int c = 0; c < 4; ++c) a[r][c] += powers[r + c];
+                    a[r][4] += y * powers[r];
+                }
+            }
+
+            // Gaussian elimination with partial pivoting
+            bool solved = true;
+            for (int col = 0; col < 4 && solved; ++col) {
+                int pivot = col;
+                for (int r = col + 1; r < 4; ++r) {
+                    if (std::abs(a[r][col]) > std::abs(a[pivot][col])) pivot = r;
+                }
+                if (std::abs(a[pivot][col]) < 1e-12) {
+                    solved = false;
+                    break;
+                }
+                for (int c = 0; c < 5; ++c) std::swap(a[col][c], a[pivot][c]);
+                for (int r = 0; r < 4; ++r) {
+                    if (r == col) continue;
+                    double f = a[r][col] / a[col][col];
+                    for (int c = col; c < 5; ++c) a[r][c] -= f * a[col][c];
+                }
+            }
+            if (solved) {
+                for (int k = 0; k < 4; ++k) coef[k] = a[k][4] / a[k][k];
+            }
+
+            // Derivative c1 + 2 c2 t + 3 c3 t^2 must be >= 0 at both ends and the vertex
+            auto slope_at = [this](double t) { return coef[1] + 2 * coef[2] * t + 3 * coef[3] * t * t; };
+            bool monotone = solved && slope_at(0.0) >= 0.0 && slope_at(1.0) >= 0.0;
+            if (monotone && coef[3] != 0.0) {
+                double vertex = -coef[2] / (3 * coef[3]);
+                if (vertex > 0.0 && vertex < 1.0) {
+                    monotone = slope_at(vertex) >= 0.0;
+                }
+            }
+            if (!monotone) {
+                coef[0] = 0.0;
+                coef[1] = leaves;
+                coef[2] = 0.0;
+                coef[3] = 0.0;
+            }
+        }
     };
 
     // Layer 1: Root model
-    LinearModel root_model_;
+    RootModel root_model_;
 
     // Layer 2: Expert models
     std::vector<LinearModel> expert_models_;
-    size_t num_experts_;
+    RMIConfig config_;
+    size_t num_threads_;  // Leaf training threads (0 = one per core)
 
     // Data storage
     std::vector<KeyType> keys_;
     std::vector<ValueType> values_;
 
-    // Dynamic buffer
-    std::vector<std::pair<KeyType, ValueType>> insert_buffer_;
+    // Updates since the last (re)train; merged and retrained when full
+    BoundedDeltaBuffer<KeyType, ValueType> buffer_;
+    size_t size_ = 0;
+
+    // Error windows wider than this are searched exponentially from the
+    // prediction instead, since a few outliers should not widen every lookup
+    static constexpr int64_t MAX_BOUNDED_WINDOW = 4096;
 
-    // Search parameters
-    static constexpr size_t ERROR_BOUND = 128;
+    // Below this many keys leaves train on the calling thread; spawning
+    // workers costs more than the training itself
+    static constexpr size_t PARALLEL_TRAIN_KEYS = 1 << 20;
+
+    // Leaves claimed per grab by a training thread
+    static constexpr size_t LEAF_BATCH = 64;
+
+    // The optimizer trains candidates on at most this many sampled keys
+    static constexpr size_t OPTIMIZER_SAMPLE = 1 << 20;
+
+    // Branching factors explored by the optimizer: 2^8 .. 2^24
+    static constexpr unsigned MIN_BRANCH_BITS = 8;
+    static constexpr unsigned MAX_BRANCH_BITS = 24;
+
+    // Random sample lookups timed per Pareto candidate
+    static constexpr size_t OPTIMIZER_PROBES = 200000;
+
+    // optimize_reproducible() takes the smallest Pareto candidate whose mean
+    // log2 search window is within this much of the most accurate one
+    static constexpr double REPRODUCIBLE_LOG2_SLACK = 0.25;
 
 public:
-    explicit RMIIndex(size_t num_experts = 100)
-        : num_experts_(num_experts) {}
+    // Models the optimizer may pick by default (about a last-level cache slice)
+    static constexpr size_t DEFAULT_MODEL_BUDGET = 16 * 1024 * 1024;
+
+    explicit RMIIndex(size_t num_experts = 100, size_t num_threads = 0)
+        : RMIIndex(RMIConfig{RMIRootType::LINEAR, num_experts}, num_threads) {}
+
+    explicit RMIIndex(const RMIConfig& config, size_t num_threads = 0)
+        : config_(config), num_threads_(num_threads) {
+        config_.branching_factor = std::max(size_t(1), config_.branching_factor);
+    }
 
     bool insert(const KeyType& key, const ValueType& value) override {
-        // Check main index
-        if (!keys_.empty()) {
-            size_t pos = predict_position(key);
-            auto it = bounded_search(key, pos);
-            if (it != keys_.end() && *it == key) {
+        if (const auto* entry = buffer_.lookup(key)) {
+            if (entry->has_value()) {
                 return false;
             }
+            // Re-insert of an erased key: the value overrides the base entry
+        } else if (base_contains(key)) {
+            return false;
         }
 
-        // Check buffer
-        for (const auto& p : insert_buffer_) {
-            if (p.first == key) {
-                return false;
-            }
+        buffer_.put(key, value);
+        size_++;
+        if (buffer_.full()) {
+            merge_buffer();
         }
-
-        insert_buffer_.push_back({key, value});
         return true;
     }
 
     std::optional<ValueType> find(const KeyType& key) const override {
+        // Buffered entries (values and tombstones) shadow the base array
+        if (!buffer_.empty()) {
+            if (const auto* entry = buffer_.lookup(key)) {
+                return *entry;
+            }
+        }
+
         // Search main index
         if (!keys_.empty()) {
-            size_t pos = predict_position(key);
-            auto it = bounded_search(key, pos);
+            auto it = search_position(key);
 
             if (it != keys_.end() && *it == key) {
                 size_t idx = std::distance(keys_.begin(), it);
@@ -125,25 +439,30 @@ public:
             }
         }
 
-        // Search buffer
-        for (const auto& p : insert_buffer_) {
-            if (p.first == key) {
-                return p.second;
-            }
-        }
-
         return std::nullopt;
     }
 
     bool erase(const KeyType& key) override {
-        // Remove from buffer
-        for (auto it = insert_buffer_.begin(); it != insert_buffer_.end(); ++it) {
-            if (it->first == key) {
-                insert_buffer_.erase(it);
-                return true;
+        if (const auto* entry = buffer_.lookup(key)) {
+            if (!entry->has_value()) {
+                return false;
+            }
+            if (base_contains(key)) {
+                buffer_.put_tombstone(key);
+            } else {
+                buffer_.remove(key);
             }
+        } else if (base_contains(key)) {
+            buffer_.put_tombstone(key);
+        } else {
+            return false;
+        }
+
+        size_--;
+        if (buffer_.full()) {
+            merge_buffer();
         }
-        return false;
+        return true;
     }
 
     void load(const std::vector<KeyType>& keys,
@@ -175,110 +494,468 @@ public:
         // Train RMI
         train_models();
 
-        insert_buffer_.clear();
+        buffer_.reset(keys_.size());
+        size_ = keys_.size();
     }
 
     size_t size() const override {
-        return keys_.size() + insert_buffer_.size();
+        return size_;
     }
 
     size_t memory_footprint() const override {
         size_t data_size = keys_.capacity() * sizeof(KeyType) +
                           values_.capacity() * sizeof(ValueType);
 
-        size_t models_size = sizeof(LinearModel) * (1 + num_experts_);
-
-        size_t buffer_size = insert_buffer_.capacity() *
-                            (sizeof(KeyType) + sizeof(ValueType));
+        size_t models_size = sizeof(RootModel) + sizeof(LinearModel) * config_.branching_factor;
 
-        return data_size + models_size + buffer_size;
+        return data_size + models_size + buffer_.memory_footprint();
     }
 
     std::string name() const override {
-        return "RMI";
+        RMIConfig default_config;
+        if (config_.root_type == default_config.root_type &&
+            config_.branching_factor == default_config.branching_factor) {
+            return "RMI";
+        }
+        return "RMI(" + config_.to_string() + ")";
     }
 
     void clear() override {
         keys_.clear();
         values_.clear();
-        insert_buffer_.clear();
+        buffer_.reset(0);
+        size_ = 0;
         expert_models_.clear();
     }
 
-private:
-    void train_models() {
-        if (keys_.empty()) return;
+    const RMIConfig& config() const { return config_; }
 
-        // Initialize expert models
-        expert_models_.resize(num_experts_);
+    const BoundedDeltaBuffer<KeyType, ValueType>& delta_buffer() const { return buffer_; }
 
-        // Train root model (Layer 1)
-        std::vector<size_t> expert_indices(keys_.size());
-        for (size_t i = 0; i < keys_.size(); ++i) {
-            expert_indices[i] = (i * num_experts_) / keys_.size();
+    /**
+     * @brief Train every root type and branching factor on a sample of keys
+     *
+     * Every stride-th key of (at most) OPTIMIZER_SAMPLE keys is sorted and
+     * each topology is trained on it; search windows measured on the sample
+     * are scaled back by the stride. Branching factors stop at two keys per
+     * leaf. Pareto candidates are then timed on random sample lookups.
+     *
+     * @param max_model_bytes Larger topologies are not trained at all
+     * @param time_lookups Time the Pareto candidates (lookup_ns stays 0 otherwise)
+     * @return Candidates ordered by model size, Pareto front flagged
+     */
+    static std::vector<RMICandidate> explore_configs(const std::vector<KeyType>& keys,
+                                                     size_t max_model_bytes = SIZE_MAX,
+                                                     bool time_lookups = true) {
+        std::vector<RMICandidate> candidates;
+        if (keys.empty()) return candidates;
+
+        size_t stride = std::max(size_t(1), keys.size() / OPTIMIZER_SAMPLE);
+        std::vector<KeyType> sample;
+        sample.reserve(keys.size() / stride + 1);
+        for (size_t i = 0; i < keys.size(); i += stride) {
+            sample.push_back(keys[i]);
+        }
+        std::sort(sample.begin(), sample.end());
+
+        const RMIRootType root_types[] = {RMIRootType::LINEAR, RMIRootType::CUBIC,
+                                          RMIRootType::LINEAR_SPLINE, RMIRootType::RADIX};
+        RootModel root;
+        std::vector<LinearModel> leaves;
+        std::vector<double> leaf_log2;
+        for (unsigned bits = MIN_BRANCH_BITS; bits <= MAX_BRANCH_BITS; ++bits) {
+            size_t branching = size_t(1) << bits;
+            if (branching * 2 > keys.size() && bits > MIN_BRANCH_BITS) break;
+            if (sizeof(RootModel) + branching * sizeof(LinearModel) > max_model_bytes &&
+                bits > MIN_BRANCH_BITS) break;
+
+            for (RMIRootType type : root_types) {
+                RMICandidate c;
+                c.config = RMIConfig{type, branching};
+                c.model_bytes = sizeof(RootModel) + branching * sizeof(LinearModel);
+
+                train_layers(sample, c.config, 1, root, leaves);
+                leaf_log2.resize(branching);
+                for (size_t e = 0; e < branching; ++e) {
+                    double window = static_cast<double>(leaves[e].max_error - leaves[e].min_error + 1) * stride;
+                    leaf_log2[e] = std::log2(window);
+                }
+                double total_log2 = 0.0;
+                for (KeyType key : sample) {
+                    total_log2 += leaf_log2[root.predict(key, branching - 1)];
+                }
+                c.avg_log2_error = total_log2 / sample.size();
+                candidates.push_back(c);
+            }
         }
 
-        root_model_.train(keys_, expert_indices);
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const RMICandidate& a, const RMICandidate& b) {
+                             return a.model_bytes < b.model_bytes ||
+                                    (a.model_bytes == b.model_bytes && a.avg_log2_error < b.avg_log2_error);
+                         });
+        double best = std::numeric_limits<double>::infinity();
+        for (auto& c : candidates) {
+            if (c.avg_log2_error < best) {
+                c.pareto = true;
+                best = c.avg_log2_error;
+            }
+        }
+        if (!time_lookups) {
+            return candidates;
+        }
 
-        // Train expert models (Layer 2)
-        for (size_t expert_id = 0; expert_id < num_experts_; ++expert_id) {
-            std::vector<KeyType> expert_keys;
-            std::vector<size_t> expert_positions;
-
-            for (size_t i = 0; i < keys_.size(); ++i) {
-                size_t predicted_expert = root_model_.predict(keys_[i], num_experts_ - 1);
-                if (predicted_expert == expert_id) {
-                    expert_keys.push_back(keys_[i]);
-                    expert_positions.push_back(i);
-                }
+        // Same probe sequence for every candidate
+        std::mt19937_64 rng(42);
+        std::vector<KeyType> probes(std::min(OPTIMIZER_PROBES, sample.size() * 4));
+        for (auto& probe : probes) {
+            probe = sample[rng() % sample.size()];
+        }
+        for (auto& c : candidates) {
+            if (!c.pareto) continue;
+            train_layers(sample, c.config, 1, root, leaves);
+
+            size_t found = 0;
+            Timer timer;
+            for (KeyType probe : probes) {
+                found += *locate(sample, root, leaves, probe) == probe;
+            }
+            c.lookup_ns = static_cast<double>(timer.elapsed_ns()) / probes.size();
+            if (found != probes.size()) {
+                throw std::logic_error("RMI optimizer candidate " + c.config.to_string() + " lost keys");
             }
+        }
+        return candidates;
+    }
+
+    /**
+     * @brief Pick the fastest Pareto topology for keys within a model size budget
+     *
+     * The choice rests on wall-clock timings, so it can differ between runs
+     * on the same keys; use optimize_reproducible() where it must not.
+     */
+    static RMIConfig optimize(const std::vector<KeyType>& keys,
+                              size_t model_budget_bytes = DEFAULT_MODEL_BUDGET) {
+        return pick_config(explore_configs(keys, model_budget_bytes), model_budget_bytes);
+    }
 
-            if (!expert_keys.empty()) {
-                expert_models_[expert_id].train(expert_keys, expert_positions);
+    /**
+     * @brief Fastest Pareto candidate within the budget (default shape if none fits)
+     */
+    static RMIConfig pick_config(const std::vector<RMICandidate>& candidates,
+                                 size_t model_budget_bytes = DEFAULT_MODEL_BUDGET) {
+        const RMICandidate* best = nullptr;
+        for (const auto& c : candidates) {
+            if (c.pareto && c.model_bytes <= model_budget_bytes &&
+                (best == nullptr || c.lookup_ns < best->lookup_ns)) {
+                best = &c;
             }
         }
+        return best != nullptr ? best->config : RMIConfig();
     }
 
-    size_t predict_position(KeyType key) const {
-        if (keys_.empty()) return 0;
+    /**
+     * @brief Pick a topology for keys from model size and accuracy alone
+     *
+     * Same keys and budget always give the same shape (no timing), for
+     * build-time code generation.
+     */
+    static RMIConfig optimize_reproducible(const std::vector<KeyType>& keys,
+                                           size_t model_budget_bytes = DEFAULT_MODEL_BUDGET) {
+        return pick_config_by_error(explore_configs(keys, model_budget_bytes, false),
+                                    model_budget_bytes);
+    }
 
-        // Layer 1: Predict expert
-        size_t expert_id = root_model_.predict(key, num_experts_ - 1);
+    /**
+     * @brief Smallest Pareto candidate within the budget whose mean log2 window
+     * is within REPRODUCIBLE_LOG2_SLACK of the most accurate one (default shape
+     * if none fits)
+     */
+    static RMIConfig pick_config_by_error(const std::vector<RMICandidate>& candidates,
+                                          size_t model_budget_bytes = DEFAULT_MODEL_BUDGET) {
+        double best_error = std::numeric_limits<double>::infinity();
+        for (const auto& c : candidates) {
+            if (c.pareto && c.model_bytes <= model_budget_bytes) {
+                best_error = std::min(best_error, c.avg_log2_error);
+            }
+        }
+        // Candidates are ordered by model size, so the first match is the smallest
+        for (const auto& c : candidates) {
+            if (c.pareto && c.model_bytes <= model_budget_bytes &&
+                c.avg_log2_error <= best_error + REPRODUCIBLE_LOG2_SLACK) {
+                return c.config;
+            }
+        }
+        return RMIConfig();
+    }
 
-        // Layer 2: Predict position within data
-        size_t pos = expert_models_[expert_id].predict(key, keys_.size() - 1);
+    /**
+     * @brief Write a C++ header that hard-codes this trained RMI
+     *
+     * Emits struct @p struct_name in namespace hali::compiled_rmi with the
+     * leaves as a constexpr array and a straight-line search_bound() that
+     * inlines the root's constants, for CompiledRMIIndex. Only the model is
+     * emitted; keys and values are still passed to load(), which checks them
+     * against the recorded fingerprint.
+     */
+    void emit_header(std::ostream& os, const std::string& struct_name,
+                     const std::string& dataset_name) const {
+        if (keys_.empty()) {
+            throw std::logic_error("emit_header() needs a loaded RMI");
+        }
+        if (!buffer_.empty()) {
+            throw std::logic_error("emit_header() needs an RMI without buffered updates");
+        }
 
-        return pos;
+        const size_t branching = config_.branching_factor;
+        const size_t max_pos = keys_.size() - 1;
+
+        os << "// Generated by rmi_codegen from the " << dataset_name << " dataset ("
+           << keys_.size() << " keys, " << config_.to_string() << "). Do not edit.\n"
+           << "#pragma once\n\n"
+           << "#include \"indexes/compiled_rmi_index.h\"\n\n"
+           << "namespace hali {\nnamespace compiled_rmi {\n\n"
+           << "struct " << struct_name << " {\n"
+           << "    using key_type = " << key_type_name() << ";\n\n"
+           << "    static constexpr const char* DATASET = \"" << dataset_name << "\";\n"
+           << "    static constexpr const char* CONFIG = \"" << config_.to_string() << "\";\n"
+           << "    static constexpr size_t NUM_KEYS = " << keys_.size() << ";\n"
+           << "    static constexpr uint64_t KEY_FINGERPRINT = " << rmi_key_fingerprint(keys_) << "ULL;\n"
+           << "    static constexpr RMIRootType ROOT_TYPE = " << root_type_literal(config_.root_type) << ";\n"
+           << "    static constexpr size_t BRANCHING = " << branching << ";\n\n"
+           << "    // {slope, intercept, min_error, max_error}; empty leaves have an empty window\n"
+           << "    static constexpr CompiledRMILeaf LEAVES[BRANCHING] = {\n";
+        for (const LinearModel& leaf : expert_models_) {
+            os << "        {" << double_literal(leaf.slope) << ", " << double_literal(leaf.intercept) << ", "
+               << (leaf.bounded ? leaf.min_error : 1) << ", " << (leaf.bounded ? leaf.max_error : -1) << "},\n";
+        }
+        os << "    };\n\n"
+           << "    /**\n"
+           << "     * @brief Window [lo, hi) of the sorted keys that holds key if it is present\n"
+           << "     */\n"
+           << "    static inline void search_bound(key_type key, size_t& lo, size_t& hi) {\n";
+
+        // Layer 1: same arithmetic as RootModel::predict() with constants folded in
+        const RootModel& root = root_model_;
+        const std::string max_leaf = double_literal(static_cast<double>(branching - 1));
+        switch (root.type) {
+            case RMIRootType::CUBIC:
+                os << "        double t = key <= " << key_literal(root.min_key) << " ? 0.0\n"
+                   << "                 : std::min(1.0, static_cast<double>(key - " << key_literal(root.min_key)
+                   << ") * " << double_literal(root.inv_range) << ");\n"
+                   << "        double r = ((" << double_literal(root.coef[3]) << " * t + "
+                   << double_literal(root.coef[2]) << ") * t + " << double_literal(root.coef[1])
+                   << ") * t + " << double_literal(root.coef[0]) << ";\n"
+                   << "        r = std::max(0.0, std::min(r, " << max_leaf << "));\n"
+                   << "        size_t leaf = static_cast<size_t>(r);\n";
+                break;
+            case RMIRootType::RADIX:
+                if (root.shift >= 64) {
+                    os << "        size_t leaf = 0;\n";
+                } else {
+                    os << "        size_t leaf = key <= " << key_literal(root.min_key) << " ? 0\n"
+                       << "                    : std::min<size_t>(static_cast<uint64_t>(key - "
+                       << key_literal(root.min_key) << ") >> " << root.shift << ", " << (branching - 1) << ");\n";
+                }
+                break;
+            default:
+                os << "        double r = " << double_literal(root.linear.slope) << " * static_cast<double>(key) + "
+                   << double_literal(root.linear.intercept) << ";\n"
+                   << "        r = std::max(0.0, std::min(r, " << max_leaf << "));\n"
+                   << "        size_t leaf = static_cast<size_t>(r);\n";
+                break;
+        }
+
+        // Layer 2: same arithmetic as LinearModel::predict() + SearchUtils::bounded_search()
+        os << "        const CompiledRMILeaf& m = LEAVES[leaf];\n"
+           << "        double pred = m.slope * static_cast<double>(key) + m.intercept;\n"
+           << "        pred = std::max(0.0, std::min(pred, " << double_literal(static_cast<double>(max_pos)) << "));\n"
+           << "        int64_t pos = static_cast<int64_t>(static_cast<size_t>(pred));\n"
+           << "        int64_t begin = std::max<int64_t>(0, pos + m.min_error);\n"
+           << "        int64_t end = std::min<int64_t>(" << keys_.size() << ", pos + m.max_error + 1);\n"
+           << "        lo = static_cast<size_t>(begin);\n"
+           << "        hi = static_cast<size_t>(std::max(begin, end));\n"
+           << "    }\n"
+           << "};\n\n"
+           << "} // namespace compiled_rmi\n} // namespace hali\n";
     }
 
-    typename std::vector<KeyType>::const_iterator
-    bounded_search(KeyType key, size_t predicted_pos) const {
-        if (keys_.empty()) return keys_.end();
+private:
+    static const char* root_type_literal(RMIRootType type) {
+        switch (type) {
+            case RMIRootType::CUBIC: return "RMIRootType::CUBIC";
+            case RMIRootType::LINEAR_SPLINE: return "RMIRootType::LINEAR_SPLINE";
+            case RMIRootType::RADIX: return "RMIRootType::RADIX";
+            default: return "RMIRootType::LINEAR";
+        }
+    }
 
-        size_t start = (predicted_pos > ERROR_BOUND) ?
-                       predicted_pos - ERROR_BOUND : 0;
-        size_t end = std::min(predicted_pos + ERROR_BOUND, keys_.size());
+    static const char* key_type_name() {
+        if (std::is_same<KeyType, uint64_t>::value) return "uint64_t";
+        if (std::is_same<KeyType, uint32_t>::value) return "uint32_t";
+        if (std::is_same<KeyType, int64_t>::value) return "int64_t";
+        if (std::is_same<KeyType, int32_t>::value) return "int32_t";
+        throw std::logic_error("emit_header() supports 32/64-bit integer keys only");
+    }
 
-        auto it = std::lower_bound(keys_.begin() + start,
-                                   keys_.begin() + end,
-                                   key);
+    static std::string key_literal(KeyType key) {
+        if (std::is_signed<KeyType>::value) {
+            return "static_cast<key_type>(" + std::to_string(static_cast<long long>(key)) + "LL)";
+        }
+        return "static_cast<key_type>(" + std::to_string(static_cast<unsigned long long>(key)) + "ULL)";
+    }
 
-        return it;
+    /**
+     * @brief Round-trip exact double literal
+     */
+    static std::string double_literal(double v) {
+        std::ostringstream out;
+        out << std::setprecision(17) << v;
+        std::string text = out.str();
+        if (text.find_first_of(".en") == std::string::npos) {
+            text += ".0";
+        }
+        return text;
+    }
+
+    void train_models() {
+        if (keys_.empty()) {
+            expert_models_.clear();
+            return;
+        }
+        train_layers(keys_, config_, num_threads_, root_model_, expert_models_);
     }
 
-    typename std::vector<KeyType>::iterator
-    bounded_search(KeyType key, size_t predicted_pos) {
+    bool base_contains(KeyType key) const {
+        if (keys_.empty()) return false;
+        auto it = search_position(key);
+        return it != keys_.end() && *it == key;
+    }
+
+    /**
+     * @brief Fold the buffer into keys_/values_ and retrain every layer
+     */
+    void merge_buffer() {
+        buffer_.merge_into(keys_, values_);
+        train_models();
+    }
+
+    /**
+     * @brief Train the root and every leaf on sorted keys in O(n) total
+     *
+     * The root is a non-decreasing function of the key, so over sorted keys
+     * each leaf owns one contiguous run; run boundaries are found by binary
+     * search instead of routing every key. Leaves then train independently,
+     * in parallel for large inputs, directly on keys without copies.
+     */
+    static void train_layers(const std::vector<KeyType>& keys, const RMIConfig& config,
+                             size_t num_threads, RootModel& root,
+                             std::vector<LinearModel>& leaves) {
+        const size_t n = keys.size();
+        const size_t max_pos = n - 1;
+        const size_t num_leaves = config.branching_factor;
+
+        // Initialize expert models (reset so stale error bounds never survive a reload)
+        leaves.assign(num_leaves, LinearModel());
+
+        // Train root model (Layer 1)
+        root.train(config.root_type, keys.data(), n, num_leaves);
+
+        // leaf_begin[e] = first key routed to leaf e or beyond. Few leaves:
+        // binary search each boundary; many leaves: one in-order routing pass
+        std::vector<size_t> leaf_begin(num_leaves + 1);
+        leaf_begin[0] = 0;
+        leaf_begin[num_leaves] = n;
+        if (num_leaves * 64 < n) {
+            for (size_t e = 1; e < num_leaves; ++e) {
+                leaf_begin[e] = std::partition_point(
+                    keys.begin() + leaf_begin[e - 1], keys.end(),
+                    [&root, e, num_leaves](KeyType k) { return root.predict(k, num_leaves - 1) < e; })
+                    - keys.begin();
+            }
+        } else {
+            size_t next = 1;
+            for (size_t i = 0; i < n && next < num_leaves; ++i) {
+                size_t leaf = root.predict(keys[i], num_leaves - 1);
+                while (next <= leaf) {
+                    leaf_begin[next++] = i;
+                }
+            }
+            while (next < num_leaves) {
+                leaf_begin[next++] = n;
+            }
+        }
+
+        // Train expert models (Layer 2)
+        auto train_leaf = [&keys, &leaves, &leaf_begin, max_pos](size_t e) {
+            size_t begin = leaf_begin[e];
+            size_t count = leaf_begin[e + 1] - begin;
+            if (count == 0) return;
+            auto position = [begin](size_t i) { return begin + i; };
+            leaves[e].train(keys.data() + begin, count, position);
+            leaves[e].record_errors(keys.data() + begin, count, position, max_pos);
+        };
+
+        size_t threads = num_threads > 0 ? num_threads
+                                         : std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, (num_leaves + LEAF_BATCH - 1) / LEAF_BATCH);
+        if (threads <= 1 || n < PARALLEL_TRAIN_KEYS) {
+            for (size_t e = 0; e < num_leaves; ++e) {
+                train_leaf(e);
+            }
+            return;
+        }
+
+        // Leaves are claimed in batches so skewed leaf sizes balance out
+        std::atomic<size_t> next_leaf{0};
+        auto worker = [num_leaves, &next_leaf, &train_leaf]() {
+            while (true) {
+                size_t first = next_leaf.fetch_add(LEAF_BATCH, std::memory_order_relaxed);
+                if (first >= num_leaves) break;
+                size_t last = std::min(num_leaves, first + LEAF_BATCH);
+                for (size_t e = first; e < last; ++e) {
+                    train_leaf(e);
+                }
+            }
+        };
+
+        std::vector<std::thread> trainers;
+        trainers.reserve(threads - 1);
+        for (size_t t = 1; t < threads; ++t) {
+            trainers.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : trainers) {
+            t.join();
+        }
+    }
+
+    /**
+     * @brief Locate the lower bound of key in keys_
+     *
+     * Searches exactly the leaf's measured error window; leaves with no
+     * training keys or an oversized window fall back to exponential search.
+     */
+    typename std::vector<KeyType>::const_iterator
+    search_position(KeyType key) const {
         if (keys_.empty()) return keys_.end();
+        return locate(keys_, root_model_, expert_models_, key);
+    }
 
-        size_t start = (predicted_pos > ERROR_BOUND) ?
-                       predicted_pos - ERROR_BOUND : 0;
-        size_t end = std::min(predicted_pos + ERROR_BOUND, keys_.size());
+    static typename std::vector<KeyType>::const_iterator
+    locate(const std::vector<KeyType>& keys, const RootModel& root,
+           const std::vector<LinearModel>& leaves, KeyType key) {
+        // Layer 1: Predict expert
+        size_t expert_id = root.predict(key, leaves.size() - 1);
+        const LinearModel& leaf = leaves[expert_id];
 
-        auto it = std::lower_bound(keys_.begin() + start,
-                                   keys_.begin() + end,
-                                   key);
+        // Layer 2: Predict position within data
+        size_t pos = leaf.predict(key, keys.size() - 1);
 
-        return it;
+        if (!leaf.bounded || leaf.max_error - leaf.min_error > MAX_BOUNDED_WINDOW) {
+            return SearchUtils::exponential_search(keys, key, pos);
+        }
+        return SearchUtils::bounded_search(keys, key, pos, leaf.min_error, leaf.max_error);
     }
 };
 
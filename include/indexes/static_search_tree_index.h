@@ -0,0 +1,276 @@
+#pragma once
+
+#include "index_interface.h"
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace hali {
+
+/**
+ * @brief Read-only implicit static B-tree (S-tree) over sorted keys
+ *
+ * Keys are laid out in nodes of NODE_KEYS = 16 (two cache lines for 64-bit
+ * keys) in BFS order, the B-ary generalization of the Eytzinger layout:
+ * node k's children are nodes k * 17 + 1 ... k * 17 + 17, so the tree has
+ * no pointers and no per-node metadata. A lookup descends from node 0; at
+ * each node the child is the number of node keys smaller than the key,
+ * counted with AVX2 comparisons for 64-bit keys. The deepest node
+ * where a key >= the search key was seen holds the lower bound.
+ *
+ * A single descent is a chain of dependent loads that prefetching cannot
+ * shorten. find_batch() interleaves BATCH_LOOKUPS descents level by level
+ * and prefetches each lookup's next node as soon as it is known, so the
+ * load overlaps the compares of the other lookups in the group.
+ *
+ * Values are stored at the same slots as their keys; the only overhead on
+ * top of keys and values is the padding of the last node.
+ *
+ * For read-only snapshots: insert() and erase() return false.
+ */
+template<typename KeyType, typename ValueType>
+class StaticSearchTreeIndex : public IndexInterface<KeyType, ValueType> {
+public:
+    static constexpr size_t NODE_KEYS = 16;
+    static constexpr size_t BATCH_LOOKUPS = 16;  // Descents interleaved by find_batch()
+
+private:
+    static_assert(std::is_integral<KeyType>::value,
+                  "StaticSearchTreeIndex requires integral key type");
+
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+    struct FreeDeleter {
+        void operator()(void* p) const { std::free(p); }
+    };
+
+    std::unique_ptr<KeyType[], FreeDeleter> tree_;  // num_nodes_ * NODE_KEYS, cache-line aligned
+    std::vector<ValueType> values_;                 // Same slots as tree_
+    size_t num_nodes_ = 0;
+    size_t size_ = 0;
+    bool has_max_key_ = false;
+
+public:
+    StaticSearchTreeIndex() = default;
+
+    bool insert(const KeyType&, const ValueType&) override {
+        return false;  // Read-only
+    }
+
+    std::optional<ValueType> find(const KeyType& key) const override {
+        return value_at(lower_bound_slot(key), key);
+    }
+
+    /**
+     * @brief find() for every key, with BATCH_LOOKUPS descents in flight
+     */
+    std::vector<std::optional<ValueType>> find_batch(const std::vector<KeyType>& keys) const {
+        std::vector<std::optional<ValueType>> results(keys.size());
+        size_t levels = height();
+
+        size_t node[BATCH_LOOKUPS];
+        size_t slot[BATCH_LOOKUPS];
+        for (size_t base = 0; base < keys.size(); base += BATCH_LOOKUPS) {
+            size_t count = std::min(BATCH_LOOKUPS, keys.size() - base);
+            for (size_t j = 0; j < count; ++j) {
+                node[j] = 0;
+                slot[j] = NOT_FOUND;
+            }
+
+            for (size_t level = 0; level < levels; ++level) {
+                for (size_t j = 0; j < count; ++j) {
+                    // The last level is partial; descents that left the tree are done
+                    if (node[j] >= num_nodes_) continue;
+                    size_t i = rank(tree_.get() + node[j] * NODE_KEYS, keys[base + j]);
+                    if (i < NODE_KEYS) {
+                        slot[j] = node[j] * NODE_KEYS + i;
+                    }
+                    node[j] = child(node[j], i);
+                    if (node[j] < num_nodes_) {
+                        const char* next = reinterpret_cast<const char*>(tree_.get() + node[j] * NODE_KEYS);
+                        __builtin_prefetch(next);
+                        __builtin_prefetch(next + ALIGNMENT);
+                    }
+                }
+            }
+
+            for (size_t j = 0; j < count; ++j) {
+                results[base + j] = value_at(slot[j], keys[base + j]);
+            }
+        }
+        return results;
+    }
+
+    bool erase(const KeyType&) override {
+        return false;  // Read-only
+    }
+
+    void load(const std::vector<KeyType>& keys,
+              const std::vector<ValueType>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("Keys and values size mismatch");
+        }
+
+        // Sort by keys; of equal keys the last one loaded wins
+        std::vector<size_t> indices(keys.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        std::stable_sort(indices.begin(), indices.end(),
+                         [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+        std::vector<KeyType> sorted_keys;
+        std::vector<ValueType> sorted_values;
+        sorted_keys.reserve(keys.size());
+        sorted_values.reserve(values.size());
+        for (size_t idx : indices) {
+            if (!sorted_keys.empty() && sorted_keys.back() == keys[idx]) {
+                sorted_values.back() = values[idx];
+                continue;
+            }
+            sorted_keys.push_back(keys[idx]);
+            sorted_values.push_back(values[idx]);
+        }
+
+        size_ = sorted_keys.size();
+        has_max_key_ = !sorted_keys.empty() &&
+                       sorted_keys.back() == std::numeric_limits<KeyType>::max();
+        num_nodes_ = (size_ + NODE_KEYS - 1) / NODE_KEYS;
+        size_t slots = num_nodes_ * NODE_KEYS;
+
+        tree_.reset();
+        if (slots > 0) {
+            size_t bytes = (slots * sizeof(KeyType) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            void* mem = std::aligned_alloc(ALIGNMENT, bytes);
+            if (!mem) throw std::bad_alloc();
+            tree_.reset(static_cast<KeyType*>(mem));
+        }
+        values_.assign(slots, ValueType());
+
+        // In-order walk of the implicit tree assigns sorted keys to slots;
+        // slots past the last key are padded with the maximum key
+        size_t next = 0;
+        fill(0, sorted_keys, sorted_values, next);
+    }
+
+    size_t size() const override {
+        return size_;
+    }
+
+    size_t memory_footprint() const override {
+        return num_nodes_ * NODE_KEYS * sizeof(KeyType) +
+               values_.capacity() * sizeof(ValueType);
+    }
+
+    std::string name() const override {
+        return "S-Tree";
+    }
+
+    void clear() override {
+        tree_.reset();
+        values_.clear();
+        num_nodes_ = 0;
+        size_ = 0;
+        has_max_key_ = false;
+    }
+
+    /**
+     * @brief Levels of the implicit tree
+     */
+    size_t height() const {
+        size_t levels = 0;
+        for (size_t covered = 0, width = 1; covered < num_nodes_; width *= NODE_KEYS + 1) {
+            covered += width;
+            levels++;
+        }
+        return levels;
+    }
+
+private:
+    static size_t child(size_t node, size_t i) {
+        return node * (NODE_KEYS + 1) + i + 1;
+    }
+
+    void fill(size_t node, const std::vector<KeyType>& keys, const std::vector<ValueType>& values,
+              size_t& next) {
+        if (node >= num_nodes_) return;
+        for (size_t i = 0; i < NODE_KEYS; ++i) {
+            fill(child(node, i), keys, values, next);
+            size_t slot = node * NODE_KEYS + i;
+            if (next < keys.size()) {
+                tree_[slot] = keys[next];
+                values_[slot] = values[next];
+                next++;
+            } else {
+                tree_[slot] = std::numeric_limits<KeyType>::max();
+            }
+        }
+        fill(child(node, NODE_KEYS), keys, values, next);
+    }
+
+    std::optional<ValueType> value_at(size_t slot, KeyType key) const {
+        if (slot != NOT_FOUND && tree_[slot] == key) {
+            // Padding slots hold the maximum key too
+            if (key == std::numeric_limits<KeyType>::max() && !has_max_key_) {
+                return std::nullopt;
+            }
+            return values_[slot];
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Number of keys in node smaller than key
+     */
+    size_t rank(const KeyType* node, KeyType key) const {
+#ifdef __AVX2__
+        if constexpr (sizeof(KeyType) == 8) {
+            // cmpgt_epi64 is signed: flip the sign bit of unsigned keys
+            const __m256i flip = _mm256_set1_epi64x(
+                std::is_signed<KeyType>::value ? 0 : std::numeric_limits<int64_t>::min());
+            __m256i needle = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(key)), flip);
+            const __m256i* lanes = reinterpret_cast<const __m256i*>(node);
+            size_t count = 0;
+            for (size_t j = 0; j < NODE_KEYS / 4; ++j) {
+                __m256i keys = _mm256_xor_si256(_mm256_load_si256(lanes + j), flip);
+                __m256i less = _mm256_cmpgt_epi64(needle, keys);
+                count += static_cast<size_t>(__builtin_popcount(
+                    _mm256_movemask_pd(_mm256_castsi256_pd(less))));
+            }
+            return count;
+        }
+#endif
+        size_t count = 0;
+        for (size_t i = 0; i < NODE_KEYS; ++i) {
+            count += node[i] < key;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Slot of the first key >= key in sorted order, NOT_FOUND if none
+     */
+    size_t lower_bound_slot(KeyType key) const {
+        size_t result = NOT_FOUND;
+        size_t node = 0;
+        while (node < num_nodes_) {
+            const KeyType* keys = tree_.get() + node * NODE_KEYS;
+            size_t i = rank(keys, key);
+            if (i < NODE_KEYS) {
+                result = node * NODE_KEYS + i;
+            }
+            node = child(node, i);
+        }
+        return result;
+    }
+};
+
+} // namespace hali
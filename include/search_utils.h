@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace hali {
+
+/**
+ * @brief Last-mile search helpers shared by the learned indexes
+ */
+class SearchUtils {
+public:
+    /**
+     * @brief Exponential (galloping) search around a predicted position
+     *
+     * Doubles the probe distance away from @p pos until the key is bracketed,
+     * then binary searches the bracket. Cost is O(log |true_pos - pos|), and the
+     * result is always correct regardless of how bad the prediction was.
+     *
+     * @param keys Sorted key array (any random-access container)
+     * @param key Key to search for
+     * @param pos Predicted position (clamped to the array)
+     * @return Iterator to the first element >= key (lower bound)
+     */
+    template<typename Container, typename KeyType>
+    static typename Container::const_iterator
+    exponential_search(const Container& keys, KeyType key, size_t pos) {
+        size_t n = keys.size();
+        if (n == 0) return keys.end();
+        if (pos >= n) pos = n - 1;
+
+        size_t lo, hi;
+        if (keys[pos] < key) {
+            // Gallop right: answer lies in (pos, n]
+            size_t bound = 1;
+            while (pos + bound < n && keys[pos + bound] < key) {
+                bound *= 2;
+            }
+            lo = pos + bound / 2 + 1;
+            hi = std::min(pos + bound + 1, n);
+        } else {
+            // Gallop left: answer lies in [0, pos]
+            size_t bound = 1;
+            while (bound <= pos && keys[pos - bound] >= key) {
+                bound *= 2;
+            }
+            lo = (bound <= pos) ? pos - bound + 1 : 0;
+            hi = pos - bound / 2 + 1;
+        }
+
+        return std::lower_bound(keys.begin() + lo, keys.begin() + hi, key);
+    }
+
+    /**
+     * @brief Binary search within [pos + min_error, pos + max_error]
+     *
+     * @param keys Sorted key array
+     * @param key Key to search for
+     * @param pos Predicted position
+     * @param min_error Most negative (true - predicted) offset seen in training
+     * @param max_error Most positive (true - predicted) offset seen in training
+     * @return Iterator to the first element >= key inside the window
+     */
+    template<typename Container, typename KeyType>
+    static typename Container::const_iterator
+    bounded_search(const Container& keys, KeyType key, size_t pos,
+                   int64_t min_error, int64_t max_error) {
+        int64_t n = static_cast<int64_t>(keys.size());
+        int64_t p = static_cast<int64_t>(pos);
+        int64_t start = std::max<int64_t>(0, p + min_error);
+        int64_t end = std::min<int64_t>(n, p + max_error + 1);
+        if (start >= end) return keys.begin() + std::min(start, n);
+
+        return std::lower_bound(keys.begin() + start, keys.begin() + end, key);
+    }
+};
+
+} // namespace hali
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hali {
+
+/**
+ * @brief Scratch file holding evicted (cold) index data
+ *
+ * Blobs are appended at the end and read back with pread(), so concurrent
+ * reads at different offsets never share a file position. Blobs are never
+ * rewritten in place: a blob whose owner goes away is only counted in
+ * dead_bytes() until reset(). The file is a cache of in-memory state, not a
+ * durable store, so it is truncated on open and removed on destruction.
+ */
+class SpillFile {
+private:
+    std::string path_;
+    int fd_ = -1;
+    uint64_t end_ = 0;  // Append offset
+
+    size_t dead_bytes_ = 0;
+    size_t num_reads_ = 0;
+    size_t bytes_read_ = 0;
+
+public:
+    explicit SpillFile(const std::string& path) : path_(path) {
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Cannot open spill file: " + path_);
+        }
+    }
+
+    ~SpillFile() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            ::unlink(path_.c_str());
+        }
+    }
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    /**
+     * @brief Write a blob at the end of the file
+     * @return Offset of the blob
+     */
+    uint64_t append(const void* data, size_t len) {
+        uint64_t offset = end_;
+        const char* p = static_cast<const char*>(data);
+        size_t done = 0;
+        while (done < len) {
+            ssize_t n = ::pwrite(fd_, p + done, len - done, static_cast<off_t>(offset + done));
+            if (n < 0) {
+                throw std::runtime_error("Spill file write failed: " + path_);
+            }
+            done += static_cast<size_t>(n);
+        }
+        end_ += len;
+        return offset;
+    }
+
+    /**
+     * @brief Read len bytes at offset into data
+     */
+    void read(uint64_t offset, void* data, size_t len) {
+        char* p = static_cast<char*>(data);
+        size_t done = 0;
+        while (done < len) {
+            ssize_t n = ::pread(fd_, p + done, len - done, static_cast<off_t>(offset + done));
+            if (n <= 0) {
+                throw std::runtime_error("Spill file read failed: " + path_);
+            }
+            done += static_cast<size_t>(n);
+        }
+        num_reads_++;
+        bytes_read_ += len;
+    }
+
+    /**
+     * @brief Record that a blob of len bytes is no longer referenced
+     */
+    void release(size_t len) {
+        dead_bytes_ += len;
+    }
+
+    /**
+     * @brief Drop every blob
+     */
+    void reset() {
+        if (::ftruncate(fd_, 0) != 0) {
+            throw std::runtime_error("Cannot truncate spill file: " + path_);
+        }
+        end_ = 0;
+        dead_bytes_ = 0;
+    }
+
+    size_t size_bytes() const { return end_; }
+    size_t dead_bytes() const { return dead_bytes_; }
+    size_t num_reads() const { return num_reads_; }
+    size_t bytes_read() const { return bytes_read_; }
+    const std::string& path() const { return path_; }
+};
+
+} // namespace hali
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+namespace hali {
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer
+ *
+ * Exactly one thread may call try_push() and exactly one (other) thread may
+ * call front()/pop(). Head and tail live on separate cache lines, and each
+ * side caches the other's index so the common case touches no shared line.
+ */
+template<typename T>
+class SPSCQueue {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> slots_;
+    size_t mask_;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};  // Next slot to read (consumer)
+    size_t cached_tail_ = 0;                           // Consumer's view of tail_
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0};  // Next slot to write (producer)
+    size_t cached_head_ = 0;                           // Producer's view of head_
+
+public:
+    /**
+     * @param capacity Minimum capacity (rounded up to a power of two)
+     */
+    explicit SPSCQueue(size_t capacity = 4096) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        slots_.resize(cap);
+        mask_ = cap - 1;
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /**
+     * @brief Enqueue an item (producer side)
+     * @return false if the queue is full
+     */
+    bool try_push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Peek at the oldest item (consumer side)
+     * @return Pointer to the item, or nullptr if the queue is empty
+     */
+    const T* front() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return nullptr;
+            }
+        }
+        return &slots_[head & mask_];
+    }
+
+    /**
+     * @brief Release the item returned by front() (consumer side)
+     */
+    void pop() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief True once every pushed item has been popped (safe from any thread)
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+};
+
+} // namespace hali
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace hali {
+
+/**
+ * @brief Adaptive radix tree over a sorted key array, built bottom-up in one pass
+ *
+ * Leaves are positions in the caller's sorted key array, so the tree holds
+ * no keys or values of its own. Construction recurses over key ranges: a
+ * range of one key becomes a leaf, otherwise the first byte at which its
+ * first and last keys differ splits it into runs that become the children
+ * of one inner node. Each node is created with its final type (Node4/16/48/
+ * 256) from the exact number of runs, so no node is ever grown or copied.
+ *
+ * Bytes shared by every key below a node are skipped (optimistic path
+ * compression): a node only records the byte position it branches on, and
+ * find() confirms the full key at the leaf.
+ */
+template<typename KeyType>
+class StaticART {
+public:
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+private:
+    static_assert(std::is_integral<KeyType>::value, "StaticART requires integral key type");
+
+    using U = typename std::make_unsigned<KeyType>::type;
+    static constexpr size_t KEY_BYTES = sizeof(KeyType);
+
+    // Child reference: node type in the top 3 bits, index in its pool below
+    using Ref = uint32_t;
+    static constexpr unsigned TYPE_SHIFT = 29;
+    static constexpr Ref INDEX_MASK = (Ref(1) << TYPE_SHIFT) - 1;
+    static constexpr Ref EMPTY = std::numeric_limits<Ref>::max();
+    enum NodeType : Ref { LEAF = 0, NODE4 = 1, NODE16 = 2, NODE48 = 3, NODE256 = 4 };
+
+    struct Node4 {
+        uint8_t depth;
+        uint8_t count;
+        uint8_t keys[4];
+        Ref children[4];
+    };
+
+    struct Node16 {
+        uint8_t depth;
+        uint8_t count;
+        uint8_t keys[16];
+        Ref children[16];
+    };
+
+    struct Node48 {
+        static constexpr uint8_t NO_CHILD = 0xFF;
+        uint8_t depth;
+        uint8_t child_index[256];
+        Ref children[48];
+    };
+
+    struct Node256 {
+        uint8_t depth;
+        Ref children[256];
+    };
+
+    std::vector<Node4> node4_;
+    std::vector<Node16> node16_;
+    std::vector<Node48> node48_;
+    std::vector<Node256> node256_;
+    Ref root_ = EMPTY;
+    size_t size_ = 0;
+
+public:
+    StaticART() = default;
+
+    /**
+     * @brief Build over keys[0, n), which must be sorted
+     *
+     * Equal keys resolve to the last of them.
+     */
+    StaticART(const KeyType* keys, size_t n) : size_(n) {
+        if (n == 0) return;
+        if (n > INDEX_MASK) {
+            throw std::length_error("StaticART supports at most 2^29 keys");
+        }
+        root_ = build(keys, 0, n, 0);
+        node4_.shrink_to_fit();
+        node16_.shrink_to_fit();
+        node48_.shrink_to_fit();
+        node256_.shrink_to_fit();
+    }
+
+    /**
+     * @brief Position of key in the array the tree was built over, or NOT_FOUND
+     */
+    size_t find(KeyType key, const KeyType* keys) const {
+        size_t pos = candidate(key);
+        return pos != NOT_FOUND && keys[pos] == key ? pos : NOT_FOUND;
+    }
+
+    /**
+     * @brief The only position that can hold key, or NOT_FOUND
+     *
+     * Follows the branch bytes without reading the key array, so the caller
+     * can fetch just that one key (e.g. from disk) to confirm the match.
+     */
+    size_t candidate(KeyType key) const {
+        U bits = to_bits(key);
+        Ref ref = root_;
+        while (ref != EMPTY) {
+            Ref index = ref & INDEX_MASK;
+            switch (ref >> TYPE_SHIFT) {
+                case LEAF:
+                    return index;
+                case NODE4: {
+                    const Node4& node = node4_[index];
+                    ref = find_child(node.keys, node.children, node.count, byte_at(bits, node.depth));
+                    break;
+                }
+                case NODE16: {
+                    const Node16& node = node16_[index];
+                    ref = find_child(node.keys, node.children, node.count, byte_at(bits, node.depth));
+                    break;
+                }
+                case NODE48: {
+                    const Node48& node = node48_[index];
+                    uint8_t slot = node.child_index[byte_at(bits, node.depth)];
+                    ref = slot == Node48::NO_CHILD ? EMPTY : node.children[slot];
+                    break;
+                }
+                default: {
+                    const Node256& node = node256_[index];
+                    ref = node.children[byte_at(bits, node.depth)];
+                    break;
+                }
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    size_t num_inner_nodes() const {
+        return node4_.size() + node16_.size() + node48_.size() + node256_.size();
+    }
+
+    size_t memory_footprint() const {
+        return node4_.capacity() * sizeof(Node4) +
+               node16_.capacity() * sizeof(Node16) +
+               node48_.capacity() * sizeof(Node48) +
+               node256_.capacity() * sizeof(Node256);
+    }
+
+private:
+    // Order-preserving unsigned form (sign bit flipped for signed keys)
+    static U to_bits(KeyType key) {
+        U bits = static_cast<U>(key);
+        if (std::is_signed<KeyType>::value) {
+            bits ^= U(1) << (KEY_BYTES * 8 - 1);
+        }
+        return bits;
+    }
+
+    // Byte d of the key, most significant first
+    static uint8_t byte_at(U bits, size_t d) {
+        return static_cast<uint8_t>(bits >> (8 * (KEY_BYTES - 1 - d)));
+    }
+
+    static Ref make_ref(NodeType type, size_t index) {
+        return (Ref(type) << TYPE_SHIFT) | static_cast<Ref>(index);
+    }
+
+    static Ref find_child(const uint8_t* keys, const Ref* children, uint8_t count, uint8_t byte) {
+        for (uint8_t i = 0; i < count; ++i) {
+            if (keys[i] == byte) return children[i];
+        }
+        return EMPTY;
+    }
+
+    /**
+     * @brief Build the subtree of keys[lo, hi), whose keys agree on bytes before depth
+     */
+    Ref build(const KeyType* keys, size_t lo, size_t hi, size_t depth) {
+        U first = to_bits(keys[lo]);
+        U last = to_bits(keys[hi - 1]);
+        if (first == last) {
+            return make_ref(LEAF, hi - 1);
+        }
+
+        // Sorted range: the first and last keys bound the common prefix
+        while (byte_at(first, depth) == byte_at(last, depth)) {
+            depth++;
+        }
+
+        // Runs of equal bytes at depth become the children
+        uint8_t run_bytes[256];
+        size_t run_starts[257];
+        size_t runs = 0;
+        for (size_t i = lo; i < hi; ++i) {
+            uint8_t byte = byte_at(to_bits(keys[i]), depth);
+            if (runs == 0 || run_bytes[runs - 1] != byte) {
+                run_bytes[runs] = byte;
+                run_starts[runs] = i;
+                runs++;
+            }
+        }
+        run_starts[runs] = hi;
+
+        // Reserve the node first; pools may reallocate while children are built
+        Ref children[256];
+        if (runs <= 4) {
+            size_t index = node4_.size();
+            node4_.emplace_back();
+            for (size_t r = 0; r < runs; ++r) {
+                children[r] = build(keys, run_starts[r], run_starts[r + 1], depth + 1);
+            }
+            Node4& node = node4_[index];
+            node.depth = static_cast<uint8_t>(depth);
+            node.count = static_cast<uint8_t>(runs);
+            for (size_t r = 0; r < runs; ++r) {
+                node.keys[r] = run_bytes[r];
+                node.children[r] = children[r];
+            }
+            return make_ref(NODE4, index);
+        }
+        if (runs <= 16) {
+            size_t index = node16_.size();
+            node16_.emplace_back();
+            for (size_t r = 0; r < runs; ++r) {
+                children[r] = build(keys, run_starts[r], run_starts[r + 1], depth + 1);
+            }
+            Node16& node = node16_[index];
+            node.depth = static_cast<uint8_t>(depth);
+            node.count = static_cast<uint8_t>(runs);
+            for (size_t r = 0; r < runs; ++r) {
+                node.keys[r] = run_bytes[r];
+                node.children[r] = children[r];
+            }
+            return make_ref(NODE16, index);
+        }
+        if (runs <= 48) {
+            size_t index = node48_.size();
+            node48_.emplace_back();
+            for (size_t r = 0; r < runs; ++r) {
+                children[r] = build(keys, run_starts[r], run_starts[r + 1], depth + 1);
+            }
+            Node48& node = node48_[index];
+            node.depth = static_cast<uint8_t>(depth);
+            std::fill(std::begin(node.child_index), std::end(node.child_index), Node48::NO_CHILD);
+            for (size_t r = 0; r < runs; ++r) {
+                node.child_index[run_bytes[r]] = static_cast<uint8_t>(r);
+                node.children[r] = children[r];
+            }
+            return make_ref(NODE48, index);
+        }
+
+        size_t index = node256_.size();
+        node256_.emplace_back();
+        for (size_t r = 0; r < runs; ++r) {
+            children[r] = build(keys, run_starts[r], run_starts[r + 1], depth + 1);
+        }
+        Node256& node = node256_[index];
+        node.depth = static_cast<uint8_t>(depth);
+        std::fill(std::begin(node.children), std::end(node.children), EMPTY);
+        for (size_t r = 0; r < runs; ++r) {
+            node.children[run_bytes[r]] = children[r];
+        }
+        return make_ref(NODE256, index);
+    }
+};
+
+} // namespace hali
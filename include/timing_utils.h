@@ -139,6 +139,14 @@ public:
         return percentile(99.0);
     }
 
+    /**
+     * @brief Get P99.9 latency
+     * @return 99.9th percentile latency in nanoseconds
+     */
+    double p999() {
+        return percentile(99.9);
+    }
+
     /**
      * @brief Get minimum latency
      * @return Minimum latency in nanoseconds
@@ -4,6 +4,9 @@
 #include <random>
 #include <cstdint>
 #include <string>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
 
 namespace hali {
 
@@ -144,6 +147,94 @@ public:
         return ops;
     }
 
+    /**
+     * @brief Generate range-spread ingest workload (90% insert, 10% find)
+     *
+     * Unlike generate_write_heavy(), new keys are drawn uniformly from
+     * [keys.front(), keys.back()] so inserts spread across range partitions.
+     * @param keys Available keys for lookups (sorted)
+     * @param num_ops Number of operations to generate
+     * @return Vector of operations
+     */
+    std::vector<Operation> generate_range_ingest(
+        const std::vector<uint64_t>& keys, size_t num_ops) {
+
+        std::vector<Operation> ops;
+        ops.reserve(num_ops);
+
+        std::uniform_real_distribution<double> op_dist(0.0, 1.0);
+        std::uniform_int_distribution<size_t> key_dist(0, keys.size() - 1);
+        std::uniform_int_distribution<uint64_t> new_key_dist(
+            keys.empty() ? 0 : keys.front(), keys.empty() ? UINT64_MAX : keys.back());
+
+        for (size_t i = 0; i < num_ops; ++i) {
+            double choice = op_dist(rng);
+
+            if (choice < 0.90 || keys.empty()) {
+                // 90% insert spread over the loaded key range
+                uint64_t new_key = new_key_dist(rng);
+                ops.emplace_back(OpType::INSERT, new_key, new_key);
+            } else {
+                // 10% find from existing keys
+                uint64_t key = keys[key_dist(rng)];
+                ops.emplace_back(OpType::FIND, key);
+            }
+        }
+
+        return ops;
+    }
+
+    /**
+     * @brief Generate skewed read-heavy workload (95% Zipfian find, 5% insert)
+     *
+     * Lookup keys follow a Zipf distribution over a fixed random permutation
+     * of @p keys, so the hot set is scattered across the key space instead of
+     * clustered at the smallest keys.
+     * @param keys Available keys for lookups
+     * @param num_ops Number of operations to generate
+     * @param theta Zipf skew (0 = uniform, 0.99 = YCSB default)
+     * @return Vector of operations
+     */
+    std::vector<Operation> generate_zipf_read_heavy(
+        const std::vector<uint64_t>& keys, size_t num_ops, double theta = 0.99) {
+
+        std::vector<Operation> ops;
+        ops.reserve(num_ops);
+
+        // CDF over popularity ranks: P(rank i) ~ 1 / (i + 1)^theta
+        std::vector<double> cdf(keys.size());
+        double total = 0.0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            total += 1.0 / std::pow(static_cast<double>(i + 1), theta);
+            cdf[i] = total;
+        }
+
+        std::vector<size_t> rank_to_key(keys.size());
+        std::iota(rank_to_key.begin(), rank_to_key.end(), size_t(0));
+        std::shuffle(rank_to_key.begin(), rank_to_key.end(), rng);
+
+        std::uniform_real_distribution<double> op_dist(0.0, 1.0);
+        std::uniform_real_distribution<double> rank_dist(0.0, total);
+        std::uniform_int_distribution<uint64_t> new_key_dist;
+
+        for (size_t i = 0; i < num_ops; ++i) {
+            double choice = op_dist(rng);
+
+            if (choice < 0.95 && !keys.empty()) {
+                // 95% find, Zipf-distributed over existing keys
+                size_t rank = std::min(keys.size() - 1, static_cast<size_t>(
+                    std::lower_bound(cdf.begin(), cdf.end(), rank_dist(rng)) - cdf.begin()));
+                ops.emplace_back(OpType::FIND, keys[rank_to_key[rank]]);
+            } else {
+                // 5% insert
+                uint64_t new_key = new_key_dist(rng);
+                ops.emplace_back(OpType::INSERT, new_key, new_key);
+            }
+        }
+
+        return ops;
+    }
+
     /**
      * @brief Get workload name as string
      */
@@ -151,6 +242,8 @@ public:
         if (type == "read_heavy") return "Read-Heavy (95R/5W)";
         if (type == "write_heavy") return "Write-Heavy (10R/90W)";
         if (type == "mixed") return "Mixed (50R/50W)";
+        if (type == "range_ingest") return "Range-Ingest (10R/90W)";
+        if (type == "zipf_read") return "Zipf-Read-Heavy (95R/5W)";
         return "Unknown";
     }
 };
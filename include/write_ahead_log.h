@@ -0,0 +1,316 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include <utility>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include "hash_utils.h"
+
+namespace hali {
+
+/**
+ * @brief Append-only write-ahead log with group commit
+ *
+ * Records are staged in memory and made durable with one write() + fdatasync()
+ * per group: when group_commit_ops records are pending, or once the oldest
+ * pending record is group_commit_us old. The age limit is enforced by a
+ * background flusher thread, so a record is durable within about
+ * group_commit_us of its append even if no further append arrives.
+ * group_commit_ops = 1 gives sync-per-operation durability (no thread).
+ * append() and flush() may block while the flusher syncs a group.
+ *
+ * Record layout: [type:1][key][value][checksum:8]. Replay stops at the first
+ * short or corrupt record (a torn tail from a crash) and truncates it away.
+ */
+template<typename KeyType, typename ValueType>
+class WriteAheadLog {
+public:
+    static_assert(std::is_trivially_copyable<KeyType>::value &&
+                  std::is_trivially_copyable<ValueType>::value,
+                  "WriteAheadLog requires trivially copyable keys and values");
+
+    enum class RecordType : uint8_t {
+        INSERT = 1,
+        ERASE = 2
+    };
+
+    struct Options {
+        size_t group_commit_ops = 128;   // Sync after this many pending records
+        uint64_t group_commit_us = 1000; // ... or once the oldest pending record is this old
+    };
+
+private:
+    static constexpr size_t PAYLOAD_SIZE = 1 + sizeof(KeyType) + sizeof(ValueType);
+    static constexpr size_t RECORD_SIZE = PAYLOAD_SIZE + sizeof(uint64_t);
+
+    std::string path_;
+    Options options_;
+    int fd_ = -1;
+
+    using Clock = std::chrono::steady_clock;
+
+    // Guards everything below against the flusher thread
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread flusher_;
+    bool stopping_ = false;
+    std::exception_ptr flush_error_;  // Failure of a background flush, rethrown to the caller
+
+    std::vector<char> pending_;   // Serialized records not yet written
+    size_t pending_records_ = 0;
+    Clock::time_point oldest_pending_;  // Staging time of the first record of a group
+
+    size_t num_syncs_ = 0;
+    size_t num_records_ = 0;
+
+public:
+    WriteAheadLog(const std::string& path, Options options = Options())
+        : path_(path), options_(options) {
+        if (options_.group_commit_ops == 0) {
+            options_.group_commit_ops = 1;
+        }
+
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Cannot open WAL file: " + path_);
+        }
+        pending_.reserve(options_.group_commit_ops * RECORD_SIZE);
+
+        if (options_.group_commit_ops > 1 && options_.group_commit_us > 0) {
+            flusher_ = std::thread([this]() { flusher_loop(); });
+        }
+    }
+
+    ~WriteAheadLog() {
+        if (flusher_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_one();
+            flusher_.join();
+        }
+        if (fd_ >= 0) {
+            try {
+                flush();
+            } catch (...) {
+                // Destructors must not throw; unsynced records are lost as after a crash
+            }
+            ::close(fd_);
+        }
+    }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    /**
+     * @brief Feed every valid record to apply(type, key, value), in log order
+     * @return Number of records replayed
+     */
+    template<typename ApplyFn>
+    size_t replay(ApplyFn&& apply) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        off_t file_size = ::lseek(fd_, 0, SEEK_END);
+        ::lseek(fd_, 0, SEEK_SET);
+
+        std::vector<char> record(RECORD_SIZE);
+        off_t valid_end = 0;
+        size_t replayed = 0;
+
+        while (valid_end + static_cast<off_t>(RECORD_SIZE) <= file_size) {
+            if (!read_fully(record.data(), RECORD_SIZE)) break;
+
+            uint64_t stored;
+            std::memcpy(&stored, record.data() + PAYLOAD_SIZE, sizeof(stored));
+            if (stored != HashUtils::xxhash64(record.data(), PAYLOAD_SIZE)) break;
+
+            KeyType key;
+            ValueType value;
+            std::memcpy(&key, record.data() + 1, sizeof(KeyType));
+            std::memcpy(&value, record.data() + 1 + sizeof(KeyType), sizeof(ValueType));
+            apply(static_cast<RecordType>(record[0]), key, value);
+
+            valid_end += RECORD_SIZE;
+            replayed++;
+        }
+
+        // Drop any torn tail so new records follow valid data
+        if (valid_end != file_size && ::ftruncate(fd_, valid_end) != 0) {
+            throw std::runtime_error("Cannot truncate WAL file: " + path_);
+        }
+        ::lseek(fd_, valid_end, SEEK_SET);
+
+        num_records_ = replayed;
+        return replayed;
+    }
+
+    /**
+     * @brief Stage a record; syncs the group if a commit threshold is reached
+     */
+    void append(RecordType type, const KeyType& key, const ValueType& value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        rethrow_flush_error();
+        bool first = pending_records_ == 0;
+        if (first) {
+            oldest_pending_ = Clock::now();
+        }
+
+        size_t offset = pending_.size();
+        pending_.resize(offset + RECORD_SIZE);
+        char* rec = pending_.data() + offset;
+        rec[0] = static_cast<char>(type);
+        std::memcpy(rec + 1, &key, sizeof(KeyType));
+        std::memcpy(rec + 1 + sizeof(KeyType), &value, sizeof(ValueType));
+        uint64_t checksum = HashUtils::xxhash64(rec, PAYLOAD_SIZE);
+        std::memcpy(rec + PAYLOAD_SIZE, &checksum, sizeof(checksum));
+
+        pending_records_++;
+        num_records_++;
+
+        if (pending_records_ >= options_.group_commit_ops ||
+            Clock::now() - oldest_pending_ >= std::chrono::microseconds(options_.group_commit_us)) {
+            flush_locked();
+        } else if (first && flusher_.joinable()) {
+            // Arm the flusher's deadline for the new group
+            lock.unlock();
+            wake_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Write and fdatasync all pending records
+     */
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rethrow_flush_error();
+        flush_locked();
+    }
+
+    /**
+     * @brief Discard the whole log (the caller has a new durable base)
+     */
+    void truncate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.clear();
+        pending_records_ = 0;
+        num_records_ = 0;
+        if (::ftruncate(fd_, 0) != 0) {
+            throw std::runtime_error("Cannot truncate WAL file: " + path_);
+        }
+        ::lseek(fd_, 0, SEEK_SET);
+    }
+
+    size_t num_syncs() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_syncs_;
+    }
+
+    size_t num_records() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_records_;
+    }
+
+    const Options& options() const { return options_; }
+
+private:
+    /**
+     * @brief Write and sync the pending group, or leave the file as it was
+     *
+     * On failure the file is cut back to where the group started and the
+     * group stays pending, so a retry rewrites it at a record boundary
+     * instead of after a fragment that replay would stop at.
+     */
+    void flush_locked() {
+        if (pending_records_ == 0) return;
+
+        off_t group_start = ::lseek(fd_, 0, SEEK_CUR);
+        if (group_start < 0) {
+            throw std::runtime_error("WAL seek failed: " + path_);
+        }
+
+        const char* p = pending_.data();
+        size_t remaining = pending_.size();
+        while (remaining > 0) {
+            ssize_t n = ::write(fd_, p, remaining);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                discard_group(group_start);
+                throw std::runtime_error("WAL write failed: " + path_);
+            }
+            p += n;
+            remaining -= static_cast<size_t>(n);
+        }
+        int rc;
+        while ((rc = ::fdatasync(fd_)) != 0 && errno == EINTR) {}
+        if (rc != 0) {
+            discard_group(group_start);
+            throw std::runtime_error("WAL fdatasync failed: " + path_);
+        }
+
+        pending_.clear();
+        pending_records_ = 0;
+        num_syncs_++;
+    }
+
+    /**
+     * @brief Sync each group once its oldest record is group_commit_us old
+     */
+    void flusher_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            if (pending_records_ == 0 || flush_error_) {
+                wake_.wait(lock);
+                continue;
+            }
+            auto deadline = oldest_pending_ + std::chrono::microseconds(options_.group_commit_us);
+            if (Clock::now() < deadline) {
+                wake_.wait_until(lock, deadline);
+                continue;
+            }
+            try {
+                flush_locked();
+            } catch (...) {
+                flush_error_ = std::current_exception();
+            }
+        }
+    }
+
+    /**
+     * @brief Drop whatever part of a failed group reached the file
+     */
+    void discard_group(off_t group_start) {
+        // If the truncate fails too, the retry still overwrites the fragment in place
+        int truncated = ::ftruncate(fd_, group_start);
+        (void)truncated;
+        ::lseek(fd_, group_start, SEEK_SET);
+    }
+
+    void rethrow_flush_error() {
+        if (flush_error_) {
+            std::rethrow_exception(std::exchange(flush_error_, nullptr));
+        }
+    }
+
+    bool read_fully(char* buf, size_t len) {
+        while (len > 0) {
+            ssize_t n = ::read(fd_, buf, len);
+            if (n <= 0) return false;
+            buf += n;
+            len -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+};
+
+} // namespace hali
@@ -4,18 +4,33 @@
 #include <map>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <cstdio>
 
 #include "index_interface.h"
 #include "indexes/btree_index.h"
 #include "indexes/hash_index.h"
+#include "indexes/concurrent_hash_index.h"
 #include "indexes/art_index.h"
+#include "indexes/alex_index.h"
 #include "indexes/pgm_index.h"
+#include "indexes/ef_pgm_index.h"
+#include "indexes/static_search_tree_index.h"
 #include "indexes/rmi_index.h"
+#include "indexes/radix_spline_index.h"
 #include "indexes/haliv2_index.h"
+#include "indexes/partitioned_hali_index.h"
+#include "indexes/compiled_rmi_index.h"
 #include "timing_utils.h"
 #include "data_generator.h"
 #include "workload_generator.h"
 
+// Generated at build time by rmi_codegen (target rmi_models)
+#if __has_include("compiled_rmi_benchmark.h")
+#include "compiled_rmi_benchmark.h"
+#define HALI_HAS_COMPILED_RMI 1
+#endif
+
 using namespace hali;
 
 /**
@@ -31,10 +46,18 @@ struct BenchmarkResults {
     double p95_lookup_ns = 0.0;
     double p99_lookup_ns = 0.0;
     double insert_throughput_ops = 0.0;
+    double p999_insert_ns = 0.0;
+    uint64_t max_insert_ns = 0;
     size_t memory_footprint_bytes = 0;
     double build_time_ms = 0.0;
     size_t dataset_size = 0;
 
+    // Structural modifications during the workload (indexes that count them)
+    bool has_node_stats = false;
+    size_t node_expansions = 0;
+    size_t node_retrains = 0;
+    size_t node_splits = 0;
+
     void print() const {
         std::cout << "\n========================================\n";
         std::cout << "Index: " << index_name << "\n";
@@ -52,10 +75,37 @@ struct BenchmarkResults {
         std::cout << "P99 Lookup:        " << p99_lookup_ns << " ns\n";
         std::cout << "Insert Throughput: " << std::setprecision(0)
                   << insert_throughput_ops << " ops/sec\n";
+        std::cout << "P99.9 Insert:      " << std::setprecision(1) << p999_insert_ns << " ns\n";
+        std::cout << "Max Insert:        " << max_insert_ns << " ns\n";
+        if (has_node_stats) {
+            std::cout << "Node Expansions:   " << node_expansions << "\n";
+            std::cout << "Node Retrains:     " << node_retrains << "\n";
+            std::cout << "Node Splits:       " << node_splits << "\n";
+        }
         std::cout << "========================================\n";
     }
 };
 
+/**
+ * @brief Record an index's structural modification counters (none by default)
+ */
+template<typename IndexType>
+void collect_node_stats(const IndexType&, BenchmarkResults&) {}
+
+/**
+ * @brief ALEX: data node expansions, retrains and splits, model node growth
+ */
+template<typename KeyType, typename ValueType>
+void collect_node_stats(const ALEXIndex<KeyType, ValueType>& index, BenchmarkResults& results) {
+    const auto& stats = index.stats();
+    results.has_node_stats = true;
+    results.node_expansions = stats.num_expand_and_scales + stats.num_expand_and_retrains +
+                              stats.num_model_node_expansions;
+    results.node_retrains = stats.num_expand_and_retrains;
+    results.node_splits = stats.num_downward_splits + stats.num_sideways_splits +
+                          stats.num_model_node_splits;
+}
+
 /**
  * @brief Run benchmark on a specific index with a specific workload
  */
@@ -99,6 +149,8 @@ BenchmarkResults run_benchmark(
         operations = wl_gen.generate_write_heavy(keys, num_operations);
     } else if (workload_type == "mixed") {
         operations = wl_gen.generate_mixed(keys, num_operations);
+    } else if (workload_type == "zipf_read") {
+        operations = wl_gen.generate_zipf_read_heavy(keys, num_operations);
     }
 
     // Execute workload and measure latencies
@@ -134,13 +186,838 @@ BenchmarkResults run_benchmark(
     if (num_inserts > 0) {
         double total_insert_time_s = insert_stats.mean() * num_inserts / 1e9;
         results.insert_throughput_ops = num_inserts / total_insert_time_s;
+        results.p999_insert_ns = insert_stats.p999();
+        results.max_insert_ns = insert_stats.max();
     }
 
+    collect_node_stats(*index, results);
+
     std::cout << " DONE" << std::endl;
 
     return results;
 }
 
+/**
+ * @brief Run WT-HALI specialized for one policy preset
+ * (speed, speed-nofilter, balanced-hash, balanced, memory)
+ */
+BenchmarkResults run_wthali_benchmark(
+    const std::string& preset,
+    const std::string& config_name,
+    const std::string& workload_type,
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    double compression_level,
+    double buffer_size,
+    bool use_arena)
+{
+    if (preset == "speed") {
+        return run_benchmark<HALIv2Speed<uint64_t, uint64_t>>(
+            config_name, workload_type, dataset_name, keys, num_operations,
+            std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(compression_level, buffer_size, use_arena));
+    } else if (preset == "speed-nofilter") {
+        return run_benchmark<HALIv2SpeedNoFilter<uint64_t, uint64_t>>(
+            config_name, workload_type, dataset_name, keys, num_operations,
+            std::make_unique<HALIv2SpeedNoFilter<uint64_t, uint64_t>>(compression_level, buffer_size, use_arena));
+    } else if (preset == "balanced-hash") {
+        return run_benchmark<HALIv2BalancedHash<uint64_t, uint64_t>>(
+            config_name, workload_type, dataset_name, keys, num_operations,
+            std::make_unique<HALIv2BalancedHash<uint64_t, uint64_t>>(compression_level, buffer_size, use_arena));
+    } else if (preset == "memory") {
+        return run_benchmark<HALIv2Memory<uint64_t, uint64_t>>(
+            config_name, workload_type, dataset_name, keys, num_operations,
+            std::make_unique<HALIv2Memory<uint64_t, uint64_t>>(compression_level, buffer_size, use_arena));
+    } else {
+        return run_benchmark<HALIv2Balanced<uint64_t, uint64_t>>(
+            config_name, workload_type, dataset_name, keys, num_operations,
+            std::make_unique<HALIv2Balanced<uint64_t, uint64_t>>(compression_level, buffer_size, use_arena));
+    }
+}
+
+/**
+ * @brief Aggregate ingest throughput of PartitionedHALI at one thread count
+ */
+struct ScalingResult {
+    std::string dataset_name;
+    size_t threads = 0;
+    double ops_per_sec = 0.0;
+    double build_time_ms = 0.0;
+};
+
+/**
+ * @brief Measure PartitionedHALI ops/sec for 1, 2, 4, ... max_threads
+ *
+ * Each thread count uses that many partitions (one owner thread each) and
+ * that many producer threads replaying disjoint slices of a range-spread
+ * ingest workload.
+ */
+std::vector<ScalingResult> run_partition_scaling(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    size_t max_threads,
+    double compression_level,
+    double buffer_size)
+{
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+
+    WorkloadGenerator wl_gen(42);
+    std::vector<Operation> operations = wl_gen.generate_range_ingest(keys, num_operations);
+
+    std::vector<ScalingResult> results;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << "\n[Running] PartitionedHALI on " << dataset_name
+                  << " with " << threads << " thread(s)..." << std::flush;
+
+        PartitionedHALIIndex<uint64_t, uint64_t> index(threads, compression_level, buffer_size);
+
+        Timer build_timer;
+        index.load(keys, values);
+        double build_time_ms = build_timer.elapsed_ms();
+
+        index.start(threads);
+
+        Timer run_timer;
+        std::vector<std::thread> producers;
+        size_t chunk = (operations.size() + threads - 1) / threads;
+        for (size_t t = 0; t < threads; ++t) {
+            producers.emplace_back([&, t]() {
+                size_t begin = std::min(operations.size(), t * chunk);
+                size_t end = std::min(operations.size(), begin + chunk);
+                for (size_t i = begin; i < end; ++i) {
+                    index.submit(t, operations[i].type, operations[i].key, operations[i].value);
+                }
+            });
+        }
+        for (auto& p : producers) {
+            p.join();
+        }
+        index.wait_idle();
+        double elapsed_s = run_timer.elapsed_s();
+        index.stop();
+
+        ScalingResult r;
+        r.dataset_name = dataset_name;
+        r.threads = threads;
+        r.ops_per_sec = operations.size() / elapsed_s;
+        r.build_time_ms = build_time_ms;
+        results.push_back(r);
+
+        std::cout << " " << std::fixed << std::setprecision(0) << r.ops_per_sec
+                  << " ops/sec" << std::endl;
+    }
+
+    return results;
+}
+
+/**
+ * @brief Aggregate throughput of one hash index at one thread count
+ */
+struct ConcurrentHashResult {
+    std::string dataset_name;
+    std::string workload_name;
+    std::string index_name;
+    size_t threads = 0;
+    double ops_per_sec = 0.0;
+};
+
+/**
+ * @brief Replay disjoint slices of operations on index from threads threads
+ * @return Aggregate operations per second
+ */
+template<typename IndexType>
+double replay_concurrently(IndexType& index, const std::vector<Operation>& operations, size_t threads) {
+    Timer run_timer;
+    std::vector<std::thread> workers;
+    size_t chunk = (operations.size() + threads - 1) / threads;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            size_t begin = std::min(operations.size(), t * chunk);
+            size_t end = std::min(operations.size(), begin + chunk);
+            for (size_t i = begin; i < end; ++i) {
+                const Operation& op = operations[i];
+                if (op.type == OpType::FIND) {
+                    index.find(op.key);
+                } else if (op.type == OpType::INSERT) {
+                    index.insert(op.key, op.value);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    return operations.size() / run_timer.elapsed_s();
+}
+
+/**
+ * @brief Measure ConcurrentHashIndex ops/sec for 1, 2, 4, ... max_threads
+ *
+ * All threads share one index and replay disjoint slices of the workload.
+ * The single-threaded HashIndex is measured once as the reference point.
+ */
+std::vector<ConcurrentHashResult> run_concurrent_hash_scaling(
+    const std::string& dataset_name,
+    const std::string& workload_type,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    size_t max_threads)
+{
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+
+    WorkloadGenerator wl_gen(42);
+    std::vector<Operation> operations;
+    if (workload_type == "read_heavy") {
+        operations = wl_gen.generate_read_heavy(keys, num_operations);
+    } else if (workload_type == "write_heavy") {
+        operations = wl_gen.generate_write_heavy(keys, num_operations);
+    } else if (workload_type == "mixed") {
+        operations = wl_gen.generate_mixed(keys, num_operations);
+    } else if (workload_type == "zipf_read") {
+        operations = wl_gen.generate_zipf_read_heavy(keys, num_operations);
+    }
+
+    std::vector<ConcurrentHashResult> results;
+    auto record = [&](const std::string& index_name, size_t threads, double ops_per_sec) {
+        ConcurrentHashResult r;
+        r.dataset_name = dataset_name;
+        r.workload_name = WorkloadGenerator::workload_name(workload_type);
+        r.index_name = index_name;
+        r.threads = threads;
+        r.ops_per_sec = ops_per_sec;
+        results.push_back(r);
+        std::cout << " " << std::fixed << std::setprecision(0) << ops_per_sec
+                  << " ops/sec" << std::endl;
+    };
+
+    std::cout << "\n[Running] HashTable on " << dataset_name << " with "
+              << workload_type << " workload, 1 thread..." << std::flush;
+    {
+        HashIndex<uint64_t, uint64_t> index;
+        index.load(keys, values);
+        record(index.name(), 1, replay_concurrently(index, operations, 1));
+    }
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << "\n[Running] ConcurrentHashTable on " << dataset_name << " with "
+                  << workload_type << " workload, " << threads << " thread(s)..." << std::flush;
+        ConcurrentHashIndex<uint64_t, uint64_t> index;
+        index.load(keys, values);
+        record(index.name(), threads, replay_concurrently(index, operations, threads));
+    }
+
+    return results;
+}
+
+/**
+ * @brief HALIv2 insert throughput under one WAL setting
+ */
+struct WALResult {
+    std::string dataset_name;
+    std::string mode;
+    double insert_throughput_ops = 0.0;
+    size_t num_syncs = 0;
+};
+
+/**
+ * @brief Compare insert throughput with WAL off, group commit, and sync-per-op
+ *
+ * Replays only the inserts of the write-heavy workload so the numbers isolate
+ * the logging cost. The log is a local file removed after each run.
+ */
+std::vector<WALResult> run_wal_benchmark(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    double compression_level,
+    double buffer_size,
+    const std::string& wal_path)
+{
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+
+    WorkloadGenerator wl_gen(42);
+    std::vector<Operation> inserts;
+    for (const auto& op : wl_gen.generate_write_heavy(keys, num_operations)) {
+        if (op.type == OpType::INSERT) {
+            inserts.push_back(op);
+        }
+    }
+
+    // 0 = WAL off, 1 = sync per operation, otherwise group size
+    const std::vector<size_t> group_sizes = {0, 1024, 128, 16, 1};
+
+    std::vector<WALResult> results;
+    for (size_t group : group_sizes) {
+        WALResult r;
+        r.dataset_name = dataset_name;
+        r.mode = (group == 0) ? "off" :
+                 (group == 1) ? "sync-per-op" : "group-" + std::to_string(group);
+
+        std::cout << "\n[Running] WAL " << r.mode << " on " << dataset_name << "..." << std::flush;
+
+        HALIv2Speed<uint64_t, uint64_t> index(compression_level, buffer_size);
+        index.load(keys, values);
+
+        std::remove(wal_path.c_str());
+        if (group > 0) {
+            WriteAheadLog<uint64_t, uint64_t>::Options options;
+            options.group_commit_ops = group;
+            options.group_commit_us = 1000;
+            index.open_wal(wal_path, options);
+        }
+
+        Timer timer;
+        for (const auto& op : inserts) {
+            index.insert(op.key, op.value);
+        }
+        index.sync_wal();
+        double elapsed_s = timer.elapsed_s();
+
+        r.insert_throughput_ops = inserts.size() / elapsed_s;
+        r.num_syncs = index.wal() ? index.wal()->num_syncs() : 0;
+        index.close_wal();
+        std::remove(wal_path.c_str());
+
+        std::cout << " " << std::fixed << std::setprecision(0) << r.insert_throughput_ops
+                  << " inserts/sec (" << r.num_syncs << " syncs)" << std::endl;
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+/**
+ * @brief Values and operations replayed by the HALIv2 feature benchmarks
+ */
+struct FeatureWorkload {
+    std::vector<uint64_t> values;
+    std::vector<Operation> operations;
+};
+
+/**
+ * @brief Values of key * 2 and the Zipf read-heavy workload over keys
+ */
+FeatureWorkload make_feature_workload(const std::vector<uint64_t>& keys, size_t num_operations) {
+    FeatureWorkload workload;
+    workload.values.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        workload.values[i] = keys[i] * 2;
+    }
+
+    WorkloadGenerator wl_gen(42);
+    workload.operations = wl_gen.generate_zipf_read_heavy(keys, num_operations);
+    return workload;
+}
+
+/**
+ * @brief Replay a workload, timing each lookup (inserts applied, not timed)
+ */
+template<typename IndexType>
+LatencyStats measure_lookups(IndexType& index, const std::vector<Operation>& operations) {
+    LatencyStats lookup_stats;
+    for (const auto& op : operations) {
+        Timer op_timer;
+        if (op.type == OpType::FIND) {
+            index.find(op.key);
+            lookup_stats.add(op_timer.elapsed_ns());
+        } else {
+            index.insert(op.key, op.value);
+        }
+    }
+    return lookup_stats;
+}
+
+/**
+ * @brief Replay only the lookups of a workload (inserts dropped, e.g. for static data)
+ */
+template<typename IndexType>
+LatencyStats measure_static_lookups(const IndexType& index, const std::vector<Operation>& operations) {
+    LatencyStats lookup_stats;
+    uint64_t found = 0;
+    for (const auto& op : operations) {
+        if (op.type != OpType::FIND) continue;
+        Timer op_timer;
+        // Use the result so inlined, side-effect-free finds are not dropped
+        found += index.find(op.key).has_value();
+        lookup_stats.add(op_timer.elapsed_ns());
+    }
+    volatile uint64_t sink = found;
+    (void)sink;
+    return lookup_stats;
+}
+
+/**
+ * @brief HALIv2 lookup latency under skewed reads at one hot-cache size
+ */
+struct HotCacheResult {
+    std::string dataset_name;
+    size_t cache_entries = 0;
+    double mean_lookup_ns = 0.0;
+    double p99_lookup_ns = 0.0;
+    double hit_rate = 0.0;
+};
+
+/**
+ * @brief Compare lookup latency with the hot-key cache off and at several sizes
+ *
+ * Replays the Zipf read-heavy workload (inserts included, so the cache also
+ * pays for invalidation) against a freshly loaded index per cache size.
+ */
+std::vector<HotCacheResult> run_hot_cache_benchmark(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    double compression_level,
+    double buffer_size)
+{
+    FeatureWorkload workload = make_feature_workload(keys, num_operations);
+
+    // 0 = cache off
+    const std::vector<size_t> cache_sizes = {0, 1024, 4096, 16384};
+
+    std::vector<HotCacheResult> results;
+    for (size_t entries : cache_sizes) {
+        HotCacheResult r;
+        r.dataset_name = dataset_name;
+        r.cache_entries = entries;
+
+        std::cout << "\n[Running] Hot cache " << (entries == 0 ? std::string("off") : std::to_string(entries))
+                  << " on " << dataset_name << "..." << std::flush;
+
+        HALIv2Speed<uint64_t, uint64_t> index(compression_level, buffer_size);
+        index.load(keys, workload.values);
+        index.enable_hot_cache(entries);
+
+        LatencyStats lookup_stats = measure_lookups(index, workload.operations);
+
+        r.mean_lookup_ns = lookup_stats.mean();
+        r.p99_lookup_ns = lookup_stats.p99();
+        r.hit_rate = index.hot_cache() ? index.hot_cache()->hit_rate() : 0.0;
+
+        std::cout << " mean " << std::fixed << std::setprecision(1) << r.mean_lookup_ns
+                  << " ns, p99 " << r.p99_lookup_ns << " ns, hit rate "
+                  << std::setprecision(3) << r.hit_rate << std::endl;
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+/**
+ * @brief HALIv2 lookup latency at one expert memory budget
+ */
+struct TieringResult {
+    std::string dataset_name;
+    double budget_fraction = 1.0;
+    size_t resident_bytes = 0;
+    double mean_lookup_ns = 0.0;
+    double p99_lookup_ns = 0.0;
+    size_t faults = 0;
+    size_t spill_reads = 0;
+};
+
+/**
+ * @brief Compare lookup latency as cold experts are spilled to disk
+ *
+ * The budget is a fraction of the fully resident PGM/RMI expert arrays.
+ * Lookups follow the Zipf read-heavy workload, so a small hot set keeps
+ * most experts cold.
+ */
+std::vector<TieringResult> run_tiering_benchmark(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    double compression_level,
+    double buffer_size,
+    const std::string& spill_path)
+{
+    FeatureWorkload workload = make_feature_workload(keys, num_operations);
+
+    const std::vector<double> budget_fractions = {1.0, 0.5, 0.25, 0.1};
+
+    std::vector<TieringResult> results;
+    for (double fraction : budget_fractions) {
+        TieringResult r;
+        r.dataset_name = dataset_name;
+        r.budget_fraction = fraction;
+
+        std::cout << "\n[Running] Tiering budget " << std::fixed << std::setprecision(0)
+                  << (fraction * 100) << "% on " << dataset_name << "..." << std::flush;
+
+        HALIv2Speed<uint64_t, uint64_t> index(compression_level, buffer_size);
+        index.load(keys, workload.values);
+        size_t full_bytes = index.resident_expert_bytes();
+        if (fraction < 1.0) {
+            index.enable_tiering(spill_path, static_cast<size_t>(full_bytes * fraction));
+        }
+
+        LatencyStats lookup_stats = measure_lookups(index, workload.operations);
+
+        r.resident_bytes = index.resident_expert_bytes();
+        r.mean_lookup_ns = lookup_stats.mean();
+        r.p99_lookup_ns = lookup_stats.p99();
+        r.faults = index.expert_faults();
+        r.spill_reads = index.spill_file() ? index.spill_file()->num_reads() : 0;
+
+        std::cout << " mean " << std::setprecision(1) << r.mean_lookup_ns
+                  << " ns, p99 " << r.p99_lookup_ns << " ns, "
+                  << r.faults << " faults, " << r.spill_reads << " reads, resident "
+                  << (r.resident_bytes / 1024.0 / 1024.0) << " MB" << std::endl;
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+/**
+ * @brief HALIv2 memory and lookup latency with cold experts compressed
+ */
+struct CompressionResult {
+    std::string dataset_name;
+    std::string mode;
+    size_t memory_footprint_bytes = 0;
+    double mean_lookup_ns = 0.0;
+    double p99_lookup_ns = 0.0;
+    size_t compressed_experts = 0;
+};
+
+/**
+ * @brief Compare plain experts with every expert compressed after load
+ *
+ * Under the Zipf read-heavy workload, hot experts decompress themselves
+ * once they have decoded as many bytes as they hold; cold ones stay packed.
+ */
+std::vector<CompressionResult> run_compression_benchmark(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    double compression_level,
+    double buffer_size)
+{
+    FeatureWorkload workload = make_feature_workload(keys, num_operations);
+
+    std::vector<CompressionResult> results;
+    for (bool compress : {false, true}) {
+        CompressionResult r;
+        r.dataset_name = dataset_name;
+        r.mode = compress ? "compressed" : "plain";
+
+        std::cout << "\n[Running] Cold compression " << r.mode << " on " << dataset_name
+                  << "..." << std::flush;
+
+        HALIv2Speed<uint64_t, uint64_t> index(compression_level, buffer_size);
+        index.load(keys, workload.values);
+        if (compress) {
+            index.enable_cold_compression(num_operations);
+            index.compress_cold_experts(0);
+        }
+        r.memory_footprint_bytes = index.memory_footprint();
+
+        LatencyStats lookup_stats = measure_lookups(index, workload.operations);
+
+        r.mean_lookup_ns = lookup_stats.mean();
+        r.p99_lookup_ns = lookup_stats.p99();
+        r.compressed_experts = index.num_compressed_experts();
+
+        std::cout << " " << std::fixed << std::setprecision(2)
+                  << (r.memory_footprint_bytes / 1024.0 / 1024.0) << " MB, mean "
+                  << std::setprecision(1) << r.mean_lookup_ns << " ns, p99 "
+                  << r.p99_lookup_ns << " ns, " << r.compressed_experts
+                  << " experts still compressed" << std::endl;
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+/**
+ * @brief HALIv2 time-to-first-query with eager or lazy expert construction
+ */
+struct LazyBuildResult {
+    std::string dataset_name;
+    std::string mode;
+    double load_ms = 0.0;
+    double first_query_us = 0.0;
+    double mean_lookup_ns = 0.0;
+    double warm_ms = 0.0;
+};
+
+/**
+ * @brief Compare eager load() with a lazy load plus background warmer
+ *
+ * Lookups follow the Zipf read-heavy workload (finds only) and run while
+ * the warmer is still building experts; warm_ms is load start to the last
+ * expert built.
+ */
+std::vector<LazyBuildResult> run_lazy_build_benchmark(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations,
+    double compression_level,
+    double buffer_size)
+{
+    FeatureWorkload workload = make_feature_workload(keys, num_operations);
+
+    std::vector<LazyBuildResult> results;
+    for (bool lazy : {false, true}) {
+        LazyBuildResult r;
+        r.dataset_name = dataset_name;
+        r.mode = lazy ? "lazy" : "eager";
+
+        std::cout << "\n[Running] " << r.mode << " build on " << dataset_name << "..." << std::flush;
+
+        HALIv2Speed<uint64_t, uint64_t> index(compression_level, buffer_size);
+        index.set_lazy_build(lazy);
+
+        Timer total_timer;
+        index.load(keys, workload.values);
+        r.load_ms = total_timer.elapsed_ms();
+        if (lazy) {
+            index.start_warmer();
+        }
+
+        Timer first_timer;
+        index.find(keys[keys.size() / 2]);
+        r.first_query_us = first_timer.elapsed_us();
+
+        r.mean_lookup_ns = measure_static_lookups(index, workload.operations).mean();
+
+        index.wait_warmer();
+        r.warm_ms = total_timer.elapsed_ms();
+
+        std::cout << " load " << std::fixed << std::setprecision(2) << r.load_ms
+                  << " ms, first query " << r.first_query_us << " us, mean lookup "
+                  << std::setprecision(1) << r.mean_lookup_ns << " ns, warm after "
+                  << std::setprecision(2) << r.warm_ms << " ms" << std::endl;
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+/**
+ * @brief Read-only lookup cost of one index on one dataset
+ */
+struct ReadOnlyResult {
+    std::string dataset_name;
+    std::string index_name;
+    size_t memory_footprint_bytes = 0;
+    double mean_lookup_ns = 0.0;    // Each lookup timed on its own
+    double p99_lookup_ns = 0.0;
+    double loop_lookup_ns = 0.0;    // One timer around all lookups, divided by their count
+    double batch_lookup_ns = 0.0;   // Same for S-tree find_batch(), 0 for the others
+};
+
+/**
+ * @brief Time back-to-back finds over lookup_keys with one timer
+ * @return Nanoseconds per lookup
+ */
+template<typename IndexType>
+double measure_lookup_loop(const IndexType& index, const std::vector<uint64_t>& lookup_keys) {
+    uint64_t found = 0;
+    Timer loop_timer;
+    for (uint64_t key : lookup_keys) {
+        auto result = index.find(key);
+        found += result.has_value() ? result.value() : 0;
+    }
+    double ns = loop_timer.elapsed_ns() / static_cast<double>(lookup_keys.size());
+    volatile uint64_t sink = found;
+    (void)sink;
+    return ns;
+}
+
+/**
+ * @brief Load one index and measure its lookups over the shared workload
+ */
+template<typename IndexType>
+ReadOnlyResult measure_read_only(const std::string& dataset_name, const std::vector<uint64_t>& keys,
+                                 const FeatureWorkload& workload,
+                                 const std::vector<uint64_t>& lookup_keys) {
+    IndexType index;
+    index.load(keys, workload.values);
+    std::cout << "\n[Running] " << index.name() << " read-only on " << dataset_name
+              << "..." << std::flush;
+
+    ReadOnlyResult r;
+    r.dataset_name = dataset_name;
+    r.index_name = index.name();
+    r.memory_footprint_bytes = index.memory_footprint();
+    LatencyStats lookup_stats = measure_static_lookups(index, workload.operations);
+    r.mean_lookup_ns = lookup_stats.mean();
+    r.p99_lookup_ns = lookup_stats.p99();
+    r.loop_lookup_ns = measure_lookup_loop(index, lookup_keys);
+
+    if constexpr (std::is_same<IndexType, StaticSearchTreeIndex<uint64_t, uint64_t>>::value) {
+        Timer batch_timer;
+        auto results = index.find_batch(lookup_keys);
+        r.batch_lookup_ns = batch_timer.elapsed_ns() / static_cast<double>(lookup_keys.size());
+        volatile bool sink = results.back().has_value();
+        (void)sink;
+    }
+
+    std::cout << " " << std::fixed << std::setprecision(2)
+              << (r.memory_footprint_bytes / 1024.0 / 1024.0) << " MB, mean "
+              << std::setprecision(1) << r.mean_lookup_ns << " ns, p99 " << r.p99_lookup_ns
+              << " ns, loop " << r.loop_lookup_ns << " ns";
+    if (r.batch_lookup_ns > 0) {
+        std::cout << ", batched " << r.batch_lookup_ns << " ns";
+    }
+    std::cout << std::endl;
+    return r;
+}
+
+/**
+ * @brief Compare S-tree lookups with BTreeIndex and PGMIndex on the same keys
+ *
+ * All three load the same keys and replay the finds of the same Zipf
+ * read-heavy workload (the S-tree is read-only, so inserts are dropped).
+ */
+std::vector<ReadOnlyResult> run_read_only_benchmark(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations)
+{
+    FeatureWorkload workload = make_feature_workload(keys, num_operations);
+    std::vector<uint64_t> lookup_keys;
+    for (const auto& op : workload.operations) {
+        if (op.type == OpType::FIND) {
+            lookup_keys.push_back(op.key);
+        }
+    }
+
+    std::vector<ReadOnlyResult> results;
+    results.push_back(measure_read_only<BTreeIndex<uint64_t, uint64_t>>(
+        dataset_name, keys, workload, lookup_keys));
+    results.push_back(measure_read_only<PGMIndex<uint64_t, uint64_t>>(
+        dataset_name, keys, workload, lookup_keys));
+    results.push_back(measure_read_only<StaticSearchTreeIndex<uint64_t, uint64_t>>(
+        dataset_name, keys, workload, lookup_keys));
+    return results;
+}
+
+/**
+ * @brief Compare the default RMI shape with the one picked by RMIIndex::optimize()
+ *
+ * Prints the Pareto front explored on the dataset, then runs the read-heavy
+ * workload on both shapes.
+ */
+std::vector<BenchmarkResults> run_rmi_optimizer_benchmark(
+    const std::string& dataset_name,
+    const std::vector<uint64_t>& keys,
+    size_t num_operations)
+{
+    std::cout << "\n[Running] RMI optimizer on " << dataset_name << "..." << std::flush;
+
+    Timer optimize_timer;
+    std::vector<RMICandidate> candidates = RMIIndex<uint64_t, uint64_t>::explore_configs(keys);
+    RMIConfig tuned = RMIIndex<uint64_t, uint64_t>::pick_config(candidates);
+    std::cout << " " << std::fixed << std::setprecision(1) << optimize_timer.elapsed_ms()
+              << " ms, picked " << tuned.to_string() << "\n";
+    for (const auto& c : candidates) {
+        if (!c.pareto) continue;
+        std::cout << "  " << std::setw(22) << std::left << c.config.to_string() << std::right
+                  << std::setw(10) << (c.model_bytes / 1024) << " KB  log2 err "
+                  << std::setprecision(2) << c.avg_log2_error << "  lookup "
+                  << std::setprecision(1) << c.lookup_ns << " ns\n";
+    }
+
+    std::vector<BenchmarkResults> results;
+    auto baseline = std::make_unique<RMIIndex<uint64_t, uint64_t>>();
+    std::string baseline_name = baseline->name();
+    results.push_back(run_benchmark<RMIIndex<uint64_t, uint64_t>>(
+        baseline_name, "read_heavy", dataset_name, keys, num_operations, std::move(baseline)));
+
+    auto optimized = std::make_unique<RMIIndex<uint64_t, uint64_t>>(tuned);
+    std::string optimized_name = optimized->name();
+    results.push_back(run_benchmark<RMIIndex<uint64_t, uint64_t>>(
+        optimized_name, "read_heavy", dataset_name, keys, num_operations, std::move(optimized)));
+
+    return results;
+}
+
+/**
+ * @brief Read latency of one code-generated RMI vs. the runtime RMI of the same shape
+ */
+struct CompiledRMIResult {
+    std::string dataset_name;
+    std::string config;
+    double runtime_mean_ns = 0.0;
+    double runtime_p99_ns = 0.0;
+    double compiled_mean_ns = 0.0;
+    double compiled_p99_ns = 0.0;
+};
+
+/**
+ * @brief Benchmark Model if the dataset it was generated for is loaded
+ */
+template<typename Model>
+void run_compiled_rmi_benchmark(const std::map<std::string, std::vector<uint64_t>>& datasets,
+                                size_t num_operations,
+                                std::vector<CompiledRMIResult>& results)
+{
+    auto it = datasets.find(Model::DATASET);
+    if (it == datasets.end()) return;
+    const std::vector<uint64_t>& keys = it->second;
+
+    if (!CompiledRMIIndex<Model>::matches(keys)) {
+        std::cout << "\n[Skipped] compiled RMI for " << Model::DATASET << " was generated for "
+                  << Model::NUM_KEYS << " keys (rebuild with -DRMI_MODEL_SIZE=" << keys.size()
+                  << " to match --size)" << std::endl;
+        return;
+    }
+
+    std::cout << "\n[Running] runtime vs. compiled RMI(" << Model::CONFIG << ") on "
+              << Model::DATASET << "..." << std::flush;
+
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+    WorkloadGenerator wl_gen(42);
+    std::vector<Operation> operations = wl_gen.generate_read_heavy(keys, num_operations);
+
+    CompiledRMIResult r;
+    r.dataset_name = Model::DATASET;
+    r.config = Model::CONFIG;
+
+    RMIIndex<uint64_t, uint64_t> runtime(RMIConfig{Model::ROOT_TYPE, Model::BRANCHING});
+    runtime.load(keys, values);
+    LatencyStats runtime_stats = measure_static_lookups(runtime, operations);
+    r.runtime_mean_ns = runtime_stats.mean();
+    r.runtime_p99_ns = runtime_stats.p99();
+
+    CompiledRMIIndex<Model> compiled;
+    compiled.load(keys, values);
+    LatencyStats compiled_stats = measure_static_lookups(compiled, operations);
+    r.compiled_mean_ns = compiled_stats.mean();
+    r.compiled_p99_ns = compiled_stats.p99();
+
+    std::cout << " runtime " << std::fixed << std::setprecision(1) << r.runtime_mean_ns
+              << " ns, compiled " << r.compiled_mean_ns << " ns mean lookup" << std::endl;
+    results.push_back(r);
+}
+
+template<typename... Models>
+std::vector<CompiledRMIResult> run_compiled_rmi_benchmarks(
+    const std::map<std::string, std::vector<uint64_t>>& datasets,
+    size_t num_operations,
+    std::tuple<Models...>)
+{
+    std::vector<CompiledRMIResult> results;
+    (run_compiled_rmi_benchmark<Models>(datasets, num_operations, results), ...);
+    return results;
+}
+
 /**
  * @brief Export results to CSV
  */
@@ -150,7 +1027,8 @@ void export_to_csv(const std::vector<BenchmarkResults>& all_results,
 
     // Header
     csv << "Index,Workload,Dataset,DatasetSize,BuildTime_ms,Memory_MB,BytesPerKey,"
-        << "MeanLookup_ns,P95Lookup_ns,P99Lookup_ns,InsertThroughput_ops\n";
+        << "MeanLookup_ns,P95Lookup_ns,P99Lookup_ns,InsertThroughput_ops,"
+        << "P999Insert_ns,MaxInsert_ns,NodeExpansions,NodeRetrains,NodeSplits\n";
 
     // Data rows
     for (const auto& r : all_results) {
@@ -164,7 +1042,15 @@ void export_to_csv(const std::vector<BenchmarkResults>& all_results,
             << r.mean_lookup_ns << ","
             << r.p95_lookup_ns << ","
             << r.p99_lookup_ns << ","
-            << r.insert_throughput_ops << "\n";
+            << r.insert_throughput_ops << ","
+            << r.p999_insert_ns << ","
+            << r.max_insert_ns << ",";
+        if (r.has_node_stats) {
+            csv << r.node_expansions << "," << r.node_retrains << "," << r.node_splits;
+        } else {
+            csv << ",,";
+        }
+        csv << "\n";
     }
 
     csv.close();
@@ -210,12 +1096,29 @@ int main(int argc, char* argv[]) {
     std::string workload_type = parse_arg(argc, argv, "--workload", "all");
     size_t dataset_size = parse_arg_size(argc, argv, "--size", 500000);
     size_t num_operations = parse_arg_size(argc, argv, "--operations", 100000);
+    std::string arena_mode = parse_arg(argc, argv, "--arena", "off");  // off, on, both
+    std::string preset = parse_arg(argc, argv, "--preset", "auto");    // auto, speed, speed-nofilter, balanced-hash, balanced, memory
+    std::string wal_path = parse_arg(argc, argv, "--wal-path", "results/wal_bench.log");
+    std::string spill_path = parse_arg(argc, argv, "--spill-path", "results/experts.spill");
+    size_t max_threads = parse_arg_size(argc, argv, "--threads",
+                                        std::max(1u, std::thread::hardware_concurrency()));
 
     std::cout << "Configuration:\n";
     std::cout << "  Index Type: " << index_type << "\n";
     if (index_type == "wthali" || index_type == "all") {
+        if (preset == "auto") {
+            // Same bands the compression level used to select at runtime
+            preset = (compression_level < 0.3) ? "speed" :
+                     (compression_level < 0.5) ? "balanced-hash" :
+                     (compression_level > 0.7) ? "memory" : "balanced";
+        }
         std::cout << "  Compression Level: " << compression_level << "\n";
+        std::cout << "  Policy Preset: " << preset << "\n";
         std::cout << "  Buffer Size: " << (buffer_size * 100) << "%\n";
+        std::cout << "  Huge-Page Arena: " << arena_mode << "\n";
+    }
+    if (index_type == "phali" || index_type == "chash") {
+        std::cout << "  Max Threads: " << max_threads << "\n";
     }
     std::cout << "  Dataset Type: " << dataset_type << "\n";
     std::cout << "  Dataset Size: " << dataset_size << " keys\n";
@@ -225,28 +1128,184 @@ int main(int argc, char* argv[]) {
     // Generate specific dataset or all datasets
     std::cout << "Generating dataset...\n";
 
-    std::map<std::string, std::vector<uint64_t>> datasets;
+    std::map<std::string, std::vector<uint64_t>> datasets =
+        DataGenerator::generate_benchmark_datasets(dataset_size, dataset_type);
+
+    std::cout << "Generated " << datasets.size() << " dataset(s).\n";
+
+    // Thread-scaling benchmark for the shared-nothing partitioned HALI
+    if (index_type == "phali") {
+        std::ofstream csv("results/partition_scaling.csv");
+        csv << "Dataset,Threads,OpsPerSec,BuildTime_ms\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& r : run_partition_scaling(dataset_name, keys, num_operations,
+                                                       max_threads, compression_level,
+                                                       buffer_size)) {
+                csv << r.dataset_name << "," << r.threads << ","
+                    << r.ops_per_sec << "," << r.build_time_ms << "\n";
+            }
+        }
+        std::cout << "\nResults exported to: results/partition_scaling.csv" << std::endl;
+        return 0;
+    }
+
+    // Thread-scaling benchmark for the sharded-lock concurrent hash table
+    if (index_type == "chash") {
+        std::vector<std::string> scaling_workloads;
+        if (workload_type == "all") {
+            scaling_workloads = {"read_heavy", "write_heavy", "mixed"};
+        } else {
+            scaling_workloads = {workload_type};
+        }
+
+        std::ofstream csv("results/concurrent_hash.csv");
+        csv << "Dataset,Workload,Index,Threads,OpsPerSec\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& workload : scaling_workloads) {
+                for (const auto& r : run_concurrent_hash_scaling(dataset_name, workload, keys,
+                                                                 num_operations, max_threads)) {
+                    csv << r.dataset_name << "," << r.workload_name << "," << r.index_name << ","
+                        << r.threads << "," << r.ops_per_sec << "\n";
+                }
+            }
+        }
+        std::cout << "\nResults exported to: results/concurrent_hash.csv" << std::endl;
+        return 0;
+    }
+
+    // Insert throughput of WT-HALI with and without the write-ahead log
+    if (index_type == "wal") {
+        std::ofstream csv("results/wal_throughput.csv");
+        csv << "Dataset,Mode,InsertThroughput_ops,Syncs\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& r : run_wal_benchmark(dataset_name, keys, num_operations,
+                                                   compression_level, buffer_size, wal_path)) {
+                csv << r.dataset_name << "," << r.mode << ","
+                    << r.insert_throughput_ops << "," << r.num_syncs << "\n";
+            }
+        }
+        std::cout << "\nResults exported to: results/wal_throughput.csv" << std::endl;
+        return 0;
+    }
 
-    if (dataset_type == "all" || dataset_type == "lognormal") {
-        datasets["Lognormal"] = DataGenerator::generate_lognormal(dataset_size);
+    // Lookup latency of WT-HALI under Zipfian reads, hot-key cache off vs on
+    if (index_type == "hotcache") {
+        std::ofstream csv("results/hot_cache.csv");
+        csv << "Dataset,CacheEntries,MeanLookup_ns,P99Lookup_ns,HitRate\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& r : run_hot_cache_benchmark(dataset_name, keys, num_operations,
+                                                         compression_level, buffer_size)) {
+                csv << r.dataset_name << "," << r.cache_entries << ","
+                    << r.mean_lookup_ns << "," << r.p99_lookup_ns << ","
+                    << r.hit_rate << "\n";
+            }
+        }
+        std::cout << "\nResults exported to: results/hot_cache.csv" << std::endl;
+        return 0;
     }
-    if (dataset_type == "all" || dataset_type == "zipfian") {
-        datasets["Zipfian"] = DataGenerator::generate_zipfian(dataset_size);
+
+    // Lookup latency of WT-HALI with cold experts spilled under a memory budget
+    if (index_type == "tiered") {
+        std::ofstream csv("results/tiering.csv");
+        csv << "Dataset,BudgetFraction,ResidentBytes,MeanLookup_ns,P99Lookup_ns,Faults,SpillReads\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& r : run_tiering_benchmark(dataset_name, keys, num_operations,
+                                                       compression_level, buffer_size,
+                                                       spill_path)) {
+                csv << r.dataset_name << "," << r.budget_fraction << ","
+                    << r.resident_bytes << "," << r.mean_lookup_ns << ","
+                    << r.p99_lookup_ns << "," << r.faults << "," << r.spill_reads << "\n";
+            }
+        }
+        std::cout << "\nResults exported to: results/tiering.csv" << std::endl;
+        return 0;
     }
-    if (dataset_type == "all" || dataset_type == "clustered") {
-        datasets["Clustered"] = DataGenerator::generate_clustered(dataset_size / 10, 10);
+
+    // Memory and lookup latency of WT-HALI with cold experts block-compressed
+    if (index_type == "coldcomp") {
+        std::ofstream csv("results/cold_compression.csv");
+        csv << "Dataset,Mode,Memory_MB,MeanLookup_ns,P99Lookup_ns,CompressedExperts\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& r : run_compression_benchmark(dataset_name, keys, num_operations,
+                                                           compression_level, buffer_size)) {
+                csv << r.dataset_name << "," << r.mode << ","
+                    << (r.memory_footprint_bytes / 1024.0 / 1024.0) << ","
+                    << r.mean_lookup_ns << "," << r.p99_lookup_ns << ","
+                    << r.compressed_experts << "\n";
+            }
+        }
+        std::cout << "\nResults exported to: results/cold_compression.csv" << std::endl;
+        return 0;
     }
-    if (dataset_type == "all" || dataset_type == "sequential") {
-        datasets["Sequential"] = DataGenerator::generate_sequential_with_gaps(dataset_size);
+
+    // Time-to-first-query of WT-HALI with eager vs. lazy expert construction
+    if (index_type == "lazy") {
+        std::ofstream csv("results/lazy_build.csv");
+        csv << "Dataset,Mode,Load_ms,FirstQuery_us,MeanLookup_ns,Warm_ms\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& r : run_lazy_build_benchmark(dataset_name, keys, num_operations,
+                                                          compression_level, buffer_size)) {
+                csv << r.dataset_name << "," << r.mode << "," << r.load_ms << ","
+                    << r.first_query_us << "," << r.mean_lookup_ns << "," << r.warm_ms << "\n";
+            }
+        }
+        std::cout << "\nResults exported to: results/lazy_build.csv" << std::endl;
+        return 0;
     }
-    if (dataset_type == "all" || dataset_type == "mixed") {
-        datasets["Mixed"] = DataGenerator::generate_mixed(dataset_size);
+
+    // Read-only lookups: S-tree (single and batched) vs. BTree and PGM on the same keys
+    if (index_type == "readonly") {
+        std::ofstream csv("results/read_only.csv");
+        csv << "Dataset,Index,Memory_MB,MeanLookup_ns,P99Lookup_ns,LoopLookup_ns,BatchLookup_ns\n";
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (const auto& r : run_read_only_benchmark(dataset_name, keys, num_operations)) {
+                csv << r.dataset_name << "," << r.index_name << ","
+                    << (r.memory_footprint_bytes / 1024.0 / 1024.0) << ","
+                    << r.mean_lookup_ns << "," << r.p99_lookup_ns << ","
+                    << r.loop_lookup_ns << ",";
+                if (r.batch_lookup_ns > 0) {
+                    csv << r.batch_lookup_ns;
+                }
+                csv << "\n";
+            }
+        }
+        std::cout << "\nResults exported to: results/read_only.csv" << std::endl;
+        return 0;
     }
-    if (dataset_type == "all" || dataset_type == "uniform") {
-        datasets["Uniform"] = DataGenerator::generate_uniform(dataset_size);
+
+    // Read latency of the default RMI shape vs. the optimizer's pick
+    if (index_type == "rmiopt") {
+        std::vector<BenchmarkResults> rmi_results;
+        for (const auto& [dataset_name, keys] : datasets) {
+            for (auto& r : run_rmi_optimizer_benchmark(dataset_name, keys, num_operations)) {
+                rmi_results.push_back(r);
+            }
+        }
+        for (const auto& r : rmi_results) {
+            r.print();
+        }
+        export_to_csv(rmi_results, "results/rmi_optimizer.csv");
+        return 0;
     }
 
-    std::cout << "Generated " << datasets.size() << " dataset(s).\n";
+    // Lookups of the build-time generated RMIs vs. runtime RMIs of the same shape
+    if (index_type == "rmigen") {
+#ifdef HALI_HAS_COMPILED_RMI
+        std::ofstream csv("results/compiled_rmi.csv");
+        csv << "Dataset,Config,RuntimeMeanLookup_ns,RuntimeP99Lookup_ns,"
+            << "CompiledMeanLookup_ns,CompiledP99Lookup_ns\n";
+        for (const auto& r : run_compiled_rmi_benchmarks(datasets, num_operations,
+                                                         compiled_rmi::benchmark_models{})) {
+            csv << r.dataset_name << "," << r.config << "," << r.runtime_mean_ns << ","
+                << r.runtime_p99_ns << "," << r.compiled_mean_ns << "," << r.compiled_p99_ns << "\n";
+        }
+        std::cout << "\nResults exported to: results/compiled_rmi.csv" << std::endl;
+        return 0;
+#else
+        std::cerr << "No compiled RMI models in this build (build the rmi_models target)\n";
+        return 1;
+#endif
+    }
 
     // Workload types
     std::vector<std::string> workloads;
@@ -256,6 +1315,14 @@ int main(int argc, char* argv[]) {
         workloads = {workload_type};
     }
 
+    // Arena settings to run WT-HALI with ("both" compares lookup latency side by side)
+    std::vector<bool> arena_settings;
+    if (arena_mode == "both") {
+        arena_settings = {false, true};
+    } else {
+        arena_settings = {arena_mode == "on"};
+    }
+
     // Store all results
     std::vector<BenchmarkResults> all_results;
 
@@ -303,6 +1370,33 @@ int main(int argc, char* argv[]) {
                 );
             }
 
+            // Run read-only PGM index over Elias-Fano compressed keys
+            if (index_type == "efpgm") {
+                all_results.push_back(
+                    run_benchmark<EliasFanoPGMIndex<uint64_t, uint64_t>>(
+                        "PGM-Index(EF)", workload, dataset_name, keys, num_operations,
+                        std::make_unique<EliasFanoPGMIndex<uint64_t, uint64_t>>())
+                );
+            }
+
+            // Run read-only static search tree (SIMD node search)
+            if (index_type == "stree") {
+                all_results.push_back(
+                    run_benchmark<StaticSearchTreeIndex<uint64_t, uint64_t>>(
+                        "S-Tree", workload, dataset_name, keys, num_operations,
+                        std::make_unique<StaticSearchTreeIndex<uint64_t, uint64_t>>())
+                );
+            }
+
+            // Run ALEX index
+            if (index_type == "all" || index_type == "alex") {
+                all_results.push_back(
+                    run_benchmark<ALEXIndex<uint64_t, uint64_t>>(
+                        "ALEX", workload, dataset_name, keys, num_operations,
+                        std::make_unique<ALEXIndex<uint64_t, uint64_t>>())
+                );
+            }
+
             // Run RMI index
             if (index_type == "all" || index_type == "rmi") {
                 all_results.push_back(
@@ -312,20 +1406,32 @@ int main(int argc, char* argv[]) {
                 );
             }
 
+            // Run RadixSpline index
+            if (index_type == "all" || index_type == "rs") {
+                all_results.push_back(
+                    run_benchmark<RadixSplineIndex<uint64_t, uint64_t>>(
+                        "RadixSpline", workload, dataset_name, keys, num_operations,
+                        std::make_unique<RadixSplineIndex<uint64_t, uint64_t>>())
+                );
+            }
+
             // Run WT-HALI (HALIv2) index with optimal configuration
             if (index_type == "all" || index_type == "wthali") {
-                std::string config_name = "WT-HALI";
-                if (index_type == "wthali") {
-                    config_name += "(comp=" + std::to_string(compression_level) +
-                                  ",buf=" + std::to_string(buffer_size) + ")";
-                }
+                for (bool use_arena : arena_settings) {
+                    std::string config_name = "WT-HALI";
+                    if (index_type == "wthali") {
+                        config_name += "(comp=" + std::to_string(compression_level) +
+                                      ",buf=" + std::to_string(buffer_size) +
+                                      (use_arena ? ",arena" : "") + ")";
+                    } else if (use_arena) {
+                        config_name += "(arena)";
+                    }
 
-                all_results.push_back(
-                    run_benchmark<HALIv2Index<uint64_t, uint64_t>>(
-                        config_name, workload, dataset_name, keys, num_operations,
-                        std::make_unique<HALIv2Index<uint64_t, uint64_t>>(
-                            compression_level, buffer_size))
-                );
+                    all_results.push_back(
+                        run_wthali_benchmark(preset, config_name, workload, dataset_name, keys,
+                                             num_operations, compression_level, buffer_size, use_arena)
+                    );
+                }
             }
         }
     }
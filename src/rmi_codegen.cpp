@@ -0,0 +1,134 @@
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <cctype>
+
+#include "indexes/rmi_index.h"
+#include "data_generator.h"
+#include "sosd_loader.h"
+#include "timing_utils.h"
+
+using namespace hali;
+
+/**
+ * @brief Parse command-line argument (e.g., --key=value)
+ */
+std::string parse_arg(int argc, char* argv[], const std::string& key, const std::string& default_val) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg.find(key + "=") == 0) {
+            return arg.substr(key.length() + 1);
+        }
+    }
+    return default_val;
+}
+
+size_t parse_arg_size(int argc, char* argv[], const std::string& key, size_t default_val) {
+    std::string val = parse_arg(argc, argv, key, "");
+    if (val.empty()) return default_val;
+    return std::stoull(val);
+}
+
+std::string to_identifier(const std::string& name) {
+    std::string id;
+    for (char c : name) {
+        id += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::tolower(c)) : '_';
+    }
+    return id;
+}
+
+/**
+ * @brief Train RMIs for a fixed set of datasets and emit them as C++ headers
+ *
+ * Writes one header per dataset (struct hali::compiled_rmi::<suite>_<dataset>)
+ * plus compiled_rmi_<suite>.h, which includes them all and lists the structs
+ * in the tuple <suite>_models. The topology of each RMI is picked by
+ * RMIIndex::optimize_reproducible() within --model-budget bytes, which uses
+ * model size and accuracy only, so a rebuild on the same data emits the
+ * same headers. --config=<root>,<branching> (e.g. linear_spline,4096) fixes
+ * the topology for every dataset instead.
+ *
+ * Suites:
+ *   benchmark  the simulator's synthetic datasets at --size keys
+ *   validate   the validation suite's datasets
+ *   sosd       one SOSD file (--sosd=path, --name=NAME, optional --size limit)
+ */
+int main(int argc, char* argv[]) {
+    std::string out_dir = parse_arg(argc, argv, "--out-dir", ".");
+    std::string suite = parse_arg(argc, argv, "--suite", "benchmark");
+    size_t dataset_size = parse_arg_size(argc, argv, "--size", 500000);
+    size_t model_budget = parse_arg_size(argc, argv, "--model-budget", 256 * 1024);
+    std::string fixed_config = parse_arg(argc, argv, "--config", "");
+    RMIConfig forced;
+    if (!fixed_config.empty()) {
+        try {
+            forced = RMIConfig::from_string(fixed_config);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    std::map<std::string, std::vector<uint64_t>> datasets;
+    if (suite == "benchmark") {
+        datasets = DataGenerator::generate_benchmark_datasets(dataset_size);
+    } else if (suite == "validate") {
+        datasets = DataGenerator::generate_validation_datasets();
+    } else if (suite == "sosd") {
+        std::string path = parse_arg(argc, argv, "--sosd", "");
+        if (path.empty()) {
+            std::cerr << "--suite=sosd needs --sosd=<file>\n";
+            return 1;
+        }
+        size_t limit = parse_arg_size(argc, argv, "--size", 0);
+        datasets[parse_arg(argc, argv, "--name", "SOSD")] = SOSDLoader::load(path, limit);
+    } else {
+        std::cerr << "Unknown suite: " << suite << " (benchmark, validate, sosd)\n";
+        return 1;
+    }
+
+    std::vector<std::string> struct_names;
+    for (const auto& [dataset_name, keys] : datasets) {
+        Timer timer;
+        RMIConfig config = fixed_config.empty()
+            ? RMIIndex<uint64_t, uint64_t>::optimize_reproducible(keys, model_budget)
+            : forced;
+        RMIIndex<uint64_t, uint64_t> rmi(config);
+        rmi.load(keys, std::vector<uint64_t>(keys.size()));
+
+        std::string struct_name = to_identifier(suite + "_" + dataset_name);
+        std::string path = out_dir + "/rmi_" + struct_name + ".h";
+        std::ofstream out(path);
+        if (!out) {
+            std::cerr << "Cannot write " << path << "\n";
+            return 1;
+        }
+        rmi.emit_header(out, struct_name, dataset_name);
+        struct_names.push_back(struct_name);
+
+        std::cout << "rmi_codegen: " << dataset_name << " (" << keys.size() << " keys) -> "
+                  << config.to_string() << " in " << static_cast<size_t>(timer.elapsed_ms())
+                  << " ms, " << path << "\n";
+    }
+
+    std::string umbrella_path = out_dir + "/compiled_rmi_" + suite + ".h";
+    std::ofstream umbrella(umbrella_path);
+    if (!umbrella) {
+        std::cerr << "Cannot write " << umbrella_path << "\n";
+        return 1;
+    }
+    umbrella << "// Generated by rmi_codegen --suite=" << suite << ". Do not edit.\n"
+             << "#pragma once\n\n"
+             << "#include <tuple>\n";
+    for (const auto& name : struct_names) {
+        umbrella << "#include \"rmi_" << name << ".h\"\n";
+    }
+    umbrella << "\nnamespace hali {\nnamespace compiled_rmi {\n\n"
+             << "using " << to_identifier(suite) << "_models = std::tuple<";
+    for (size_t i = 0; i < struct_names.size(); ++i) {
+        umbrella << (i > 0 ? ", " : "") << struct_names[i];
+    }
+    umbrella << ">;\n\n} // namespace compiled_rmi\n} // namespace hali\n";
+
+    return 0;
+}
@@ -2,16 +2,35 @@
 #include <cassert>
 #include <vector>
 #include <random>
+#include <set>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <csignal>
+#include <sys/resource.h>
 
 #include "index_interface.h"
 #include "indexes/btree_index.h"
 #include "indexes/hash_index.h"
+#include "indexes/concurrent_hash_index.h"
 #include "indexes/art_index.h"
+#include "indexes/alex_index.h"
 #include "indexes/pgm_index.h"
+#include "indexes/ef_pgm_index.h"
+#include "indexes/static_search_tree_index.h"
 #include "indexes/rmi_index.h"
+#include "indexes/radix_spline_index.h"
 #include "indexes/haliv2_index.h"
+#include "indexes/partitioned_hali_index.h"
+#include "indexes/compiled_rmi_index.h"
 #include "data_generator.h"
 
+// Generated at build time by rmi_codegen (target rmi_models)
+#if __has_include("compiled_rmi_validate.h")
+#include "compiled_rmi_validate.h"
+#define HALI_HAS_COMPILED_RMI 1
+#endif
+
 using namespace hali;
 
 template<typename IndexType>
@@ -102,6 +121,598 @@ bool validate_index(const std::string& name, const std::vector<uint64_t>& keys,
     return true;
 }
 
+/**
+ * @brief Insert keys until merges fold them into WT-HALI experts, then erase them
+ *
+ * Erases every inserted key and every other loaded key, re-inserts some of
+ * the erased ones under new values and merges again, checking find(),
+ * erase() and size() against the expected contents throughout.
+ */
+template<typename IndexType>
+bool validate_erase_after_merge(const std::string& name, const std::vector<uint64_t>& keys,
+                                std::unique_ptr<IndexType> index) {
+    std::cout << "Validating " << name << " erase after merge..." << std::flush;
+
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+    index->load(keys, values);
+
+    // New keys inside the loaded range, enough for several memtable flushes
+    // and, at a high merge threshold, level compactions
+    std::set<uint64_t> present(keys.begin(), keys.end());
+    std::mt19937_64 rng(777);
+    std::uniform_int_distribution<uint64_t> dist(keys.front(), keys.back());
+    std::vector<uint64_t> inserted;
+    while (inserted.size() < 40000) {
+        uint64_t key = dist(rng);
+        if (present.insert(key).second) {
+            inserted.push_back(key);
+            if (!index->insert(key, key * 2)) {
+                std::cout << " FAIL (insert of new key " << key << " returned false)\n";
+                return false;
+            }
+        }
+    }
+    while (index->merge_step()) {}
+    if (index->merges_completed() == 0) {
+        std::cout << " FAIL (no merge completed)\n";
+        return false;
+    }
+
+    std::vector<uint64_t> erased(inserted);
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        erased.push_back(keys[i]);
+    }
+    for (uint64_t key : erased) {
+        if (!index->erase(key)) {
+            std::cout << " FAIL (erase of key " << key << " returned false)\n";
+            return false;
+        }
+        if (index->find(key).has_value() || index->erase(key)) {
+            std::cout << " FAIL (key " << key << " still present after erase)\n";
+            return false;
+        }
+    }
+    size_t expected = keys.size() + inserted.size() - erased.size();
+    if (index->size() != expected) {
+        std::cout << " FAIL (size after erase: expected " << expected
+                  << ", got " << index->size() << ")\n";
+        return false;
+    }
+    for (size_t i = 1; i < keys.size(); i += 2) {
+        auto result = index->find(keys[i]);
+        if (!result.has_value() || result.value() != values[i]) {
+            std::cout << " FAIL (kept key " << keys[i] << " lost)\n";
+            return false;
+        }
+    }
+
+    // Re-insert erased keys with new values and merge them over their tombstones
+    for (size_t i = 0; i < erased.size(); i += 3) {
+        if (!index->insert(erased[i], erased[i] + 1)) {
+            std::cout << " FAIL (re-insert of erased key " << erased[i] << " returned false)\n";
+            return false;
+        }
+        expected++;
+    }
+    while (index->merge_step()) {}
+    for (size_t i = 0; i < erased.size(); ++i) {
+        auto result = index->find(erased[i]);
+        bool reinserted = i % 3 == 0;
+        if (result.has_value() != reinserted || (reinserted && result.value() != erased[i] + 1)) {
+            std::cout << " FAIL (wrong result for re-inserted key " << erased[i] << ")\n";
+            return false;
+        }
+    }
+    if (index->size() != expected) {
+        std::cout << " FAIL (size after re-insert: expected " << expected
+                  << ", got " << index->size() << ")\n";
+        return false;
+    }
+
+    std::cout << " PASS (" << erased.size() << " erased, "
+              << index->merges_completed() << " merges)\n";
+    return true;
+}
+
+/**
+ * @brief Append keys past the loaded range until the tail seals into experts, then erase them
+ */
+template<typename IndexType>
+bool validate_erase_after_seal(const std::string& name, const std::vector<uint64_t>& keys,
+                               std::unique_ptr<IndexType> index) {
+    std::cout << "Validating " << name << " erase after tail seal..." << std::flush;
+
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+    index->load(keys, values);
+    size_t loaded_experts = index->num_experts();
+
+    std::vector<uint64_t> appended;
+    for (uint64_t i = 1; i <= 50000; ++i) {
+        appended.push_back(keys.back() + i * 3);
+        if (!index->insert(appended.back(), appended.back() * 2)) {
+            std::cout << " FAIL (append of key " << appended.back() << " returned false)\n";
+            return false;
+        }
+    }
+    if (index->num_experts() == loaded_experts) {
+        std::cout << " FAIL (tail never sealed)\n";
+        return false;
+    }
+
+    for (size_t i = 0; i < appended.size(); i += 2) {
+        if (!index->erase(appended[i])) {
+            std::cout << " FAIL (erase of appended key " << appended[i] << " returned false)\n";
+            return false;
+        }
+        if (index->find(appended[i]).has_value() || index->erase(appended[i])) {
+            std::cout << " FAIL (appended key " << appended[i] << " still present after erase)\n";
+            return false;
+        }
+    }
+    for (size_t i = 1; i < appended.size(); i += 2) {
+        auto result = index->find(appended[i]);
+        if (!result.has_value() || result.value() != appended[i] * 2) {
+            std::cout << " FAIL (kept appended key " << appended[i] << " lost)\n";
+            return false;
+        }
+    }
+    size_t expected = keys.size() + appended.size() / 2;
+    if (index->size() != expected) {
+        std::cout << " FAIL (size after erase: expected " << expected
+                  << ", got " << index->size() << ")\n";
+        return false;
+    }
+
+    std::cout << " PASS (" << index->num_experts() - loaded_experts << " sealed experts)\n";
+    return true;
+}
+
+/**
+ * @brief Submit inserts to PartitionedHALI from several threads, then stop() without waiting
+ *
+ * stop() must drain every request submitted before it was called.
+ */
+bool validate_partitioned_stop(const std::vector<uint64_t>& keys) {
+    std::cout << "Validating PartitionedHALI stop() after concurrent submits..." << std::flush;
+
+    constexpr size_t PRODUCERS = 4;
+    constexpr uint64_t KEYS_PER_PRODUCER = 20000;
+
+    for (int round = 0; round < 10; ++round) {
+        PartitionedHALIIndex<uint64_t, uint64_t> index(4, 0.25, 0.005);
+        std::vector<uint64_t> values(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            values[i] = keys[i] * 2;
+        }
+        index.load(keys, values);
+
+        // Small queues keep producers and workers interleaved up to the end
+        index.start(PRODUCERS, 64);
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&index, &keys, p]() {
+                for (uint64_t i = 1; i <= KEYS_PER_PRODUCER; ++i) {
+                    uint64_t key = keys.back() + i * PRODUCERS + p;
+                    index.submit(p, OpType::INSERT, key, key * 2);
+                }
+            });
+        }
+        for (auto& t : producers) {
+            t.join();
+        }
+        index.stop();
+
+        size_t expected = keys.size() + PRODUCERS * KEYS_PER_PRODUCER;
+        if (index.size() != expected || index.completed_hits() != PRODUCERS * KEYS_PER_PRODUCER) {
+            std::cout << " FAIL (round " << round << ": size " << index.size()
+                      << ", expected " << expected << ")\n";
+            return false;
+        }
+        for (size_t p = 0; p < PRODUCERS; ++p) {
+            for (uint64_t i = 1; i <= KEYS_PER_PRODUCER; ++i) {
+                uint64_t key = keys.back() + i * PRODUCERS + p;
+                auto result = index.find(key);
+                if (!result.has_value() || result.value() != key * 2) {
+                    std::cout << " FAIL (submitted key " << key << " not applied)\n";
+                    return false;
+                }
+            }
+        }
+    }
+
+    std::cout << " PASS\n";
+    return true;
+}
+
+/**
+ * @brief Submitted FINDs must report their values back through Completions
+ *
+ * Also checks that workers sleep once idle: with no requests in flight,
+ * the process may use only a fraction of one core, and a request
+ * submitted after that must still wake its worker.
+ */
+bool validate_partitioned_completions(const std::vector<uint64_t>& keys) {
+    std::cout << "Validating PartitionedHALI completions and idle parking..." << std::flush;
+
+    using Index = PartitionedHALIIndex<uint64_t, uint64_t>;
+    constexpr size_t PRODUCERS = 2;
+    Index index(4, 0.25, 0.005);
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+    index.load(keys, values);
+    index.start(PRODUCERS, 64);
+
+    // Each producer looks up every other key and the successor of each (mostly misses)
+    std::vector<Index::Completion> hits(keys.size());
+    std::vector<Index::Completion> misses(keys.size());
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (size_t i = p; i < keys.size(); i += PRODUCERS) {
+                index.submit(p, OpType::FIND, keys[i], 0, &hits[i]);
+                index.submit(p, OpType::FIND, keys[i] + 1, 0, &misses[i]);
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    index.wait_idle();
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        bool present = std::binary_search(keys.begin(), keys.end(), keys[i] + 1);
+        if (!hits[i].done() || hits[i].value != std::optional<uint64_t>(values[i]) ||
+            !misses[i].done() || misses[i].hit != present) {
+            std::cout << " FAIL (wrong completion for key " << keys[i] << ")\n";
+            return false;
+        }
+    }
+
+    // Let the workers run out of spins, then measure CPU use while idle
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto cpu_ms = []() {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+               (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+    };
+    double cpu_before = cpu_ms();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    double idle_cpu = cpu_ms() - cpu_before;
+
+    Index::Completion late;
+    uint64_t new_key = keys.back() + 1;
+    index.submit(0, OpType::INSERT, new_key, 7, &late);
+    index.wait_idle();
+    index.stop();
+
+    if (!late.done() || !late.hit || index.find(new_key) != std::optional<uint64_t>(7)) {
+        std::cout << " FAIL (insert submitted to parked workers not applied)\n";
+        return false;
+    }
+    if (idle_cpu > 50.0) {
+        std::cout << " FAIL (" << idle_cpu << " ms CPU in 200 ms with no requests)\n";
+        return false;
+    }
+    std::cout << " PASS (" << idle_cpu << " ms CPU in 200 ms idle)\n";
+    return true;
+}
+
+/**
+ * @brief Log updates to a WT-HALI write-ahead log, then recover them into a fresh index
+ *
+ * No explicit sync: the last group must reach the file through the
+ * group_commit_us deadline alone.
+ */
+bool validate_wal_recovery(const std::vector<uint64_t>& keys) {
+    std::cout << "Validating WT-HALI WAL recovery..." << std::flush;
+
+    const std::string path = "validate_wal.log";
+    std::remove(path.c_str());
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+
+    using Index = HALIv2Speed<uint64_t, uint64_t>;
+    using WAL = WriteAheadLog<uint64_t, uint64_t>;
+    typename WAL::Options options;
+    options.group_commit_ops = 64;
+    options.group_commit_us = 1000;
+
+    Index writer(0.25, 0.005);
+    writer.load(keys, values);
+    writer.open_wal(path, options);
+
+    // 1000 inserts and 500 erases: not a multiple of the group size
+    size_t logged = 0;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        logged += writer.insert(keys.back() + i, i);
+    }
+    for (size_t i = 0; i < 1000; i += 2) {
+        logged += writer.erase(keys[i]);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    size_t durable = WAL(path).replay([](WAL::RecordType, uint64_t, uint64_t) {});
+    if (durable != logged) {
+        std::cout << " FAIL (" << durable << " of " << logged
+                  << " records durable after the group commit deadline)\n";
+        return false;
+    }
+
+    Index recovered(0.25, 0.005);
+    recovered.load(keys, values);
+    size_t replayed = recovered.open_wal(path, options);
+    bool ok = replayed == logged && recovered.size() == writer.size();
+    for (uint64_t i = 1; ok && i <= 1000; ++i) {
+        auto result = recovered.find(keys.back() + i);
+        ok = result.has_value() && result.value() == i;
+    }
+    for (size_t i = 0; ok && i < 1000; ++i) {
+        ok = recovered.find(keys[i]).has_value() == (i % 2 == 1);
+    }
+    recovered.close_wal();
+    writer.close_wal();
+    std::remove(path.c_str());
+
+    if (!ok) {
+        std::cout << " FAIL (recovered index differs: " << replayed << " of " << logged
+                  << " records replayed)\n";
+        return false;
+    }
+    std::cout << " PASS (" << replayed << " records replayed)\n";
+    return true;
+}
+
+/**
+ * @brief WAL group whose write() fails partway must not break later replay
+ *
+ * A file-size limit makes the second group's write() stop mid-record; once
+ * the limit is lifted the retried flush must leave every record replayable.
+ */
+bool validate_wal_failed_flush() {
+    std::cout << "Validating WAL retry after a failed flush..." << std::flush;
+
+    using WAL = WriteAheadLog<uint64_t, uint64_t>;
+    const std::string path = "validate_wal_fail.log";
+    std::remove(path.c_str());
+
+    rlimit saved;
+    getrlimit(RLIMIT_FSIZE, &saved);
+    auto saved_handler = std::signal(SIGXFSZ, SIG_IGN);
+
+    typename WAL::Options options;
+    options.group_commit_ops = 1000;
+    options.group_commit_us = 60 * 1000 * 1000;  // Only explicit flushes
+    const size_t group = 10;
+    bool threw = false;
+    {
+        WAL wal(path, options);
+        for (uint64_t i = 0; i < group; ++i) {
+            wal.append(WAL::RecordType::INSERT, i, i);
+        }
+        wal.flush();
+
+        // Room for the first group and part of one record of the second
+        int fd = ::open(path.c_str(), O_RDONLY);
+        off_t limit = ::lseek(fd, 0, SEEK_END) + 90;
+        ::close(fd);
+        rlimit capped = saved;
+        capped.rlim_cur = static_cast<rlim_t>(limit);
+        setrlimit(RLIMIT_FSIZE, &capped);
+
+        for (uint64_t i = group; i < 2 * group; ++i) {
+            wal.append(WAL::RecordType::INSERT, i, i);
+        }
+        try {
+            wal.flush();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        setrlimit(RLIMIT_FSIZE, &saved);
+        wal.flush();
+    }
+    std::signal(SIGXFSZ, saved_handler);
+
+    size_t expected_key = 0;
+    bool in_order = true;
+    size_t replayed = WAL(path).replay([&](WAL::RecordType, uint64_t key, uint64_t) {
+        in_order &= key == expected_key++;
+    });
+    std::remove(path.c_str());
+
+    if (!threw || replayed != 2 * group || !in_order) {
+        std::cout << " FAIL (" << (threw ? "" : "no write error, ") << replayed
+                  << " of " << 2 * group << " records replayed)\n";
+        return false;
+    }
+    std::cout << " PASS (" << replayed << " records replayed)\n";
+    return true;
+}
+
+/**
+ * @brief S-tree find_batch() must agree with find() on hits and misses
+ */
+bool validate_stree_batch(const std::vector<uint64_t>& keys) {
+    std::cout << "Validating S-Tree batched lookups..." << std::flush;
+
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+    StaticSearchTreeIndex<uint64_t, uint64_t> index;
+    index.load(keys, values);
+
+    // Every key, each followed by a neighbour that may be a miss; the odd
+    // count leaves a partial group at the end
+    std::vector<uint64_t> probes;
+    for (uint64_t k : keys) {
+        probes.push_back(k);
+        probes.push_back(k + 1);
+    }
+    probes.push_back(std::numeric_limits<uint64_t>::max());
+
+    auto results = index.find_batch(probes);
+    for (size_t i = 0; i < probes.size(); ++i) {
+        if (results[i] != index.find(probes[i])) {
+            std::cout << " FAIL (batch differs from find() for key " << probes[i] << ")\n";
+            return false;
+        }
+    }
+    std::cout << " PASS (verified " << probes.size() << " lookups)\n";
+    return true;
+}
+
+/**
+ * @brief WT-HALI (speed preset) with the hot-key cache in front of find()
+ */
+std::unique_ptr<HALIv2Speed<uint64_t, uint64_t>> make_hot_cached_hali() {
+    auto index = std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 0.005);
+    index->enable_hot_cache(1024);
+    return index;
+}
+
+/**
+ * @brief WT-HALI (speed preset) keeping at most 16 KB of expert arrays in memory
+ */
+std::unique_ptr<HALIv2Speed<uint64_t, uint64_t>> make_tiered_hali() {
+    auto index = std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 0.005);
+    index->enable_tiering("validate_experts.spill", 16 * 1024);
+    return index;
+}
+
+/**
+ * @brief Every expert, ART included, must compress and spill and still answer
+ */
+bool validate_cold_experts(const std::string& name, const std::vector<uint64_t>& keys) {
+    std::cout << "Validating " << name << " cold experts..." << std::flush;
+
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+    auto check = [&](const HALIv2Speed<uint64_t, uint64_t>& index) {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto result = index.find(keys[i]);
+            if (!result || *result != values[i]) return false;
+            if (index.find(keys[i] + 1).has_value() &&
+                !std::binary_search(keys.begin(), keys.end(), keys[i] + 1)) return false;
+        }
+        return true;
+    };
+
+    HALIv2Speed<uint64_t, uint64_t> compressed(0.25, 0.005);
+    compressed.load(keys, values);
+    compressed.enable_cold_compression(1000000);
+    size_t packed = compressed.compress_cold_experts(0);
+    if (packed != compressed.num_experts() || !check(compressed)) {
+        std::cout << " FAIL (" << packed << " of " << compressed.num_experts()
+                  << " experts compressed)\n";
+        return false;
+    }
+
+    HALIv2Speed<uint64_t, uint64_t> tiered(0.25, 0.005);
+    tiered.load(keys, values);
+    tiered.enable_tiering("validate_cold.spill", 0);
+    size_t resident = tiered.resident_expert_bytes();
+    bool found = check(tiered);
+    tiered.disable_tiering();
+    if (resident != 0 || !found) {
+        std::cout << " FAIL (" << resident << " bytes of expert arrays resident under a zero budget)\n";
+        return false;
+    }
+    std::cout << " PASS (" << packed << " experts compressed and spilled)\n";
+    return true;
+}
+
+/**
+ * @brief The automatic cold sweep must compress at most one expert per lookup
+ */
+bool validate_cold_sweep(const std::vector<uint64_t>& keys) {
+    std::cout << "Validating WT-HALI bounded cold sweep..." << std::flush;
+
+    std::vector<uint64_t> values(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values[i] = keys[i] * 2;
+    }
+    HALIv2Speed<uint64_t, uint64_t> index(0.25, 0.005);
+    index.load(keys, values);
+    index.enable_cold_compression(1);
+
+    // Every lookup makes all other experts cold
+    size_t most = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        size_t before = index.num_compressed_experts();
+        auto result = index.find(keys[i]);
+        if (!result || *result != values[i]) {
+            std::cout << " FAIL (key " << keys[i] << " lost while sweeping)\n";
+            return false;
+        }
+        size_t after = index.num_compressed_experts();
+        most = std::max(most, after > before ? after - before : 0);
+    }
+    if (most > 1) {
+        std::cout << " FAIL (" << most << " experts compressed by one lookup)\n";
+        return false;
+    }
+    std::cout << " PASS (" << index.num_experts() << " experts, at most "
+              << most << " compressed per lookup)\n";
+    return true;
+}
+
+/**
+ * @brief WT-HALI (speed preset) that block-compresses every expert right after load
+ */
+class CompressedHALI : public HALIv2Speed<uint64_t, uint64_t> {
+public:
+    CompressedHALI() : HALIv2Speed<uint64_t, uint64_t>(0.25, 0.005) {
+        enable_cold_compression(1000);
+    }
+
+    void load(const std::vector<uint64_t>& keys, const std::vector<uint64_t>& values) override {
+        HALIv2Speed<uint64_t, uint64_t>::load(keys, values);
+        compress_cold_experts(0);
+    }
+};
+
+/**
+ * @brief WT-HALI (speed preset) loaded lazily, validated while the warmer runs
+ */
+class LazyHALI : public HALIv2Speed<uint64_t, uint64_t> {
+public:
+    LazyHALI() : HALIv2Speed<uint64_t, uint64_t>(0.25, 0.005) {
+        set_lazy_build(true);
+    }
+
+    void load(const std::vector<uint64_t>& keys, const std::vector<uint64_t>& values) override {
+        HALIv2Speed<uint64_t, uint64_t>::load(keys, values);
+        start_warmer();
+    }
+};
+
+/**
+ * @brief RMI with a fixed root family and branching factor
+ */
+std::unique_ptr<RMIIndex<uint64_t, uint64_t>> make_rmi(RMIRootType root_type, size_t branching_factor) {
+    return std::make_unique<RMIIndex<uint64_t, uint64_t>>(RMIConfig{root_type, branching_factor});
+}
+
+/**
+ * @brief RMI shaped by RMIIndex::optimize() for the keys it will load
+ */
+std::unique_ptr<RMIIndex<uint64_t, uint64_t>> make_optimized_rmi(const std::vector<uint64_t>& keys) {
+    return std::make_unique<RMIIndex<uint64_t, uint64_t>>(RMIIndex<uint64_t, uint64_t>::optimize(keys));
+}
+
 int main() {
     std::cout << "===========================================\n";
     std::cout << "  HALI Validation Suite\n";
@@ -109,9 +720,10 @@ int main() {
 
     // Generate test datasets
     std::cout << "Generating test datasets...\n";
-    auto clustered = DataGenerator::generate_clustered(1000, 5);
-    auto sequential = DataGenerator::generate_sequential_with_gaps(10000);
-    auto uniform = DataGenerator::generate_uniform(5000);
+    auto datasets = DataGenerator::generate_validation_datasets();
+    const auto& clustered = datasets["Clustered"];
+    const auto& sequential = datasets["Sequential"];
+    const auto& uniform = datasets["Uniform"];
 
     std::cout << "Clustered: " << clustered.size() << " keys\n";
     std::cout << "Sequential: " << sequential.size() << " keys\n";
@@ -123,32 +735,156 @@ int main() {
 
     std::cout << "Testing with Clustered data:\n";
     all_passed &= validate_index<BTreeIndex<uint64_t, uint64_t>>("BTree", clustered);
+    all_passed &= validate_index<StaticSearchTreeIndex<uint64_t, uint64_t>>("S-Tree", clustered);
+    all_passed &= validate_stree_batch(clustered);
     all_passed &= validate_index<HashIndex<uint64_t, uint64_t>>("HashTable", clustered);
+    all_passed &= validate_index<ConcurrentHashIndex<uint64_t, uint64_t>>("ConcurrentHashTable", clustered);
     all_passed &= validate_index<ARTIndex<uint64_t, uint64_t>>("ART", clustered);
+    all_passed &= validate_index<ALEXIndex<uint64_t, uint64_t>>("ALEX", clustered);
     all_passed &= validate_index<PGMIndex<uint64_t, uint64_t>>("PGM-Index", clustered);
+    all_passed &= validate_index<EliasFanoPGMIndex<uint64_t, uint64_t>>("PGM-Index(EF)", clustered);
     all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI", clustered);
-    all_passed &= validate_index<HALIv2Index<uint64_t, uint64_t>>("WT-HALI", clustered,
-        std::make_unique<HALIv2Index<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<RadixSplineIndex<uint64_t, uint64_t>>("RadixSpline", clustered);
+    all_passed &= validate_index<RadixSplineIndex<uint64_t, uint64_t>>("RadixSpline(err=4,bits=12)", clustered,
+        std::make_unique<RadixSplineIndex<uint64_t, uint64_t>>(4, 12));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(cubic)", clustered,
+        make_rmi(RMIRootType::CUBIC, 256));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(radix)", clustered,
+        make_rmi(RMIRootType::RADIX, 1024));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(optimized)", clustered,
+        make_optimized_rmi(clustered));
+#ifdef HALI_HAS_COMPILED_RMI
+    all_passed &= validate_index<CompiledRMIIndex<compiled_rmi::validate_clustered>>("RMI(compiled)", clustered);
+#endif
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI", clustered,
+        std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<HALIv2Balanced<uint64_t, uint64_t>>("WT-HALI(balanced)", clustered,
+        std::make_unique<HALIv2Balanced<uint64_t, uint64_t>>(0.5, 0.005));
+    all_passed &= validate_index<HALIv2Memory<uint64_t, uint64_t>>("WT-HALI(memory)", clustered,
+        std::make_unique<HALIv2Memory<uint64_t, uint64_t>>(0.75, 0.005));
+    all_passed &= validate_index<HALIv2BalancedHash<uint64_t, uint64_t>>("WT-HALI(balanced-hash)", clustered,
+        std::make_unique<HALIv2BalancedHash<uint64_t, uint64_t>>(0.4, 0.005));
+    all_passed &= validate_index<HALIv2SpeedNoFilter<uint64_t, uint64_t>>("WT-HALI(no filter)", clustered,
+        std::make_unique<HALIv2SpeedNoFilter<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI(hot cache)", clustered,
+        make_hot_cached_hali());
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI(tiered)", clustered,
+        make_tiered_hali());
+    all_passed &= validate_index<CompressedHALI>("WT-HALI(compressed)", clustered);
+    all_passed &= validate_index<LazyHALI>("WT-HALI(lazy)", clustered);
+    all_passed &= validate_index<PartitionedHALIIndex<uint64_t, uint64_t>>("PartitionedHALI", clustered,
+        std::make_unique<PartitionedHALIIndex<uint64_t, uint64_t>>(4, 0.25, 0.005));
     std::cout << "\n";
 
     std::cout << "Testing with Sequential data:\n";
     all_passed &= validate_index<BTreeIndex<uint64_t, uint64_t>>("BTree", sequential);
+    all_passed &= validate_index<StaticSearchTreeIndex<uint64_t, uint64_t>>("S-Tree", sequential);
+    all_passed &= validate_stree_batch(sequential);
     all_passed &= validate_index<HashIndex<uint64_t, uint64_t>>("HashTable", sequential);
+    all_passed &= validate_index<ConcurrentHashIndex<uint64_t, uint64_t>>("ConcurrentHashTable", sequential);
     all_passed &= validate_index<ARTIndex<uint64_t, uint64_t>>("ART", sequential);
+    all_passed &= validate_index<ALEXIndex<uint64_t, uint64_t>>("ALEX", sequential);
     all_passed &= validate_index<PGMIndex<uint64_t, uint64_t>>("PGM-Index", sequential);
+    all_passed &= validate_index<EliasFanoPGMIndex<uint64_t, uint64_t>>("PGM-Index(EF)", sequential);
     all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI", sequential);
-    all_passed &= validate_index<HALIv2Index<uint64_t, uint64_t>>("WT-HALI", sequential,
-        std::make_unique<HALIv2Index<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<RadixSplineIndex<uint64_t, uint64_t>>("RadixSpline", sequential);
+    all_passed &= validate_index<RadixSplineIndex<uint64_t, uint64_t>>("RadixSpline(err=4,bits=12)", sequential,
+        std::make_unique<RadixSplineIndex<uint64_t, uint64_t>>(4, 12));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(cubic)", sequential,
+        make_rmi(RMIRootType::CUBIC, 256));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(radix)", sequential,
+        make_rmi(RMIRootType::RADIX, 1024));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(optimized)", sequential,
+        make_optimized_rmi(sequential));
+#ifdef HALI_HAS_COMPILED_RMI
+    all_passed &= validate_index<CompiledRMIIndex<compiled_rmi::validate_sequential>>("RMI(compiled)", sequential);
+#endif
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI", sequential,
+        std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<HALIv2Balanced<uint64_t, uint64_t>>("WT-HALI(balanced)", sequential,
+        std::make_unique<HALIv2Balanced<uint64_t, uint64_t>>(0.5, 0.005));
+    all_passed &= validate_index<HALIv2Memory<uint64_t, uint64_t>>("WT-HALI(memory)", sequential,
+        std::make_unique<HALIv2Memory<uint64_t, uint64_t>>(0.75, 0.005));
+    all_passed &= validate_index<HALIv2BalancedHash<uint64_t, uint64_t>>("WT-HALI(balanced-hash)", sequential,
+        std::make_unique<HALIv2BalancedHash<uint64_t, uint64_t>>(0.4, 0.005));
+    all_passed &= validate_index<HALIv2SpeedNoFilter<uint64_t, uint64_t>>("WT-HALI(no filter)", sequential,
+        std::make_unique<HALIv2SpeedNoFilter<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI(hot cache)", sequential,
+        make_hot_cached_hali());
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI(tiered)", sequential,
+        make_tiered_hali());
+    all_passed &= validate_index<CompressedHALI>("WT-HALI(compressed)", sequential);
+    all_passed &= validate_index<LazyHALI>("WT-HALI(lazy)", sequential);
+    all_passed &= validate_index<PartitionedHALIIndex<uint64_t, uint64_t>>("PartitionedHALI", sequential,
+        std::make_unique<PartitionedHALIIndex<uint64_t, uint64_t>>(4, 0.25, 0.005));
     std::cout << "\n";
 
     std::cout << "Testing with Uniform data:\n";
     all_passed &= validate_index<BTreeIndex<uint64_t, uint64_t>>("BTree", uniform);
+    all_passed &= validate_index<StaticSearchTreeIndex<uint64_t, uint64_t>>("S-Tree", uniform);
+    all_passed &= validate_stree_batch(uniform);
     all_passed &= validate_index<HashIndex<uint64_t, uint64_t>>("HashTable", uniform);
+    all_passed &= validate_index<ConcurrentHashIndex<uint64_t, uint64_t>>("ConcurrentHashTable", uniform);
     all_passed &= validate_index<ARTIndex<uint64_t, uint64_t>>("ART", uniform);
+    all_passed &= validate_index<ALEXIndex<uint64_t, uint64_t>>("ALEX", uniform);
     all_passed &= validate_index<PGMIndex<uint64_t, uint64_t>>("PGM-Index", uniform);
+    all_passed &= validate_index<EliasFanoPGMIndex<uint64_t, uint64_t>>("PGM-Index(EF)", uniform);
     all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI", uniform);
-    all_passed &= validate_index<HALIv2Index<uint64_t, uint64_t>>("WT-HALI", uniform,
-        std::make_unique<HALIv2Index<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<RadixSplineIndex<uint64_t, uint64_t>>("RadixSpline", uniform);
+    all_passed &= validate_index<RadixSplineIndex<uint64_t, uint64_t>>("RadixSpline(err=4,bits=12)", uniform,
+        std::make_unique<RadixSplineIndex<uint64_t, uint64_t>>(4, 12));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(cubic)", uniform,
+        make_rmi(RMIRootType::CUBIC, 256));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(radix)", uniform,
+        make_rmi(RMIRootType::RADIX, 1024));
+    all_passed &= validate_index<RMIIndex<uint64_t, uint64_t>>("RMI(optimized)", uniform,
+        make_optimized_rmi(uniform));
+#ifdef HALI_HAS_COMPILED_RMI
+    all_passed &= validate_index<CompiledRMIIndex<compiled_rmi::validate_uniform>>("RMI(compiled)", uniform);
+#endif
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI", uniform,
+        std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<HALIv2Balanced<uint64_t, uint64_t>>("WT-HALI(balanced)", uniform,
+        std::make_unique<HALIv2Balanced<uint64_t, uint64_t>>(0.5, 0.005));
+    all_passed &= validate_index<HALIv2Memory<uint64_t, uint64_t>>("WT-HALI(memory)", uniform,
+        std::make_unique<HALIv2Memory<uint64_t, uint64_t>>(0.75, 0.005));
+    all_passed &= validate_index<HALIv2BalancedHash<uint64_t, uint64_t>>("WT-HALI(balanced-hash)", uniform,
+        std::make_unique<HALIv2BalancedHash<uint64_t, uint64_t>>(0.4, 0.005));
+    all_passed &= validate_index<HALIv2SpeedNoFilter<uint64_t, uint64_t>>("WT-HALI(no filter)", uniform,
+        std::make_unique<HALIv2SpeedNoFilter<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI(hot cache)", uniform,
+        make_hot_cached_hali());
+    all_passed &= validate_index<HALIv2Speed<uint64_t, uint64_t>>("WT-HALI(tiered)", uniform,
+        make_tiered_hali());
+    all_passed &= validate_index<CompressedHALI>("WT-HALI(compressed)", uniform);
+    all_passed &= validate_index<LazyHALI>("WT-HALI(lazy)", uniform);
+    all_passed &= validate_index<PartitionedHALIIndex<uint64_t, uint64_t>>("PartitionedHALI", uniform,
+        std::make_unique<PartitionedHALIIndex<uint64_t, uint64_t>>(4, 0.25, 0.005));
+    std::cout << "\n";
+
+    std::cout << "Testing WT-HALI updates:\n";
+    all_passed &= validate_erase_after_merge("WT-HALI", uniform,
+        std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_erase_after_merge("WT-HALI(balanced)", clustered,
+        std::make_unique<HALIv2Balanced<uint64_t, uint64_t>>(0.5, 0.005));
+    all_passed &= validate_erase_after_merge("WT-HALI(memory)", sequential,
+        std::make_unique<HALIv2Memory<uint64_t, uint64_t>>(0.75, 0.005));
+    all_passed &= validate_erase_after_merge("WT-HALI(no filter)", uniform,
+        std::make_unique<HALIv2SpeedNoFilter<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_erase_after_merge("WT-HALI(tiered)", uniform, make_tiered_hali());
+    all_passed &= validate_erase_after_merge("WT-HALI(leveled)", uniform,
+        std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 5.0));
+    all_passed &= validate_cold_experts("WT-HALI", clustered);
+    all_passed &= validate_cold_experts("WT-HALI", uniform);
+    all_passed &= validate_cold_sweep(clustered);
+    all_passed &= validate_erase_after_seal("WT-HALI", sequential,
+        std::make_unique<HALIv2Speed<uint64_t, uint64_t>>(0.25, 0.005));
+    all_passed &= validate_erase_after_seal("WT-HALI(memory)", uniform,
+        std::make_unique<HALIv2Memory<uint64_t, uint64_t>>(0.75, 0.005));
+    all_passed &= validate_wal_recovery(uniform);
+    all_passed &= validate_wal_failed_flush();
+    all_passed &= validate_partitioned_stop(uniform);
+    all_passed &= validate_partitioned_completions(uniform);
     std::cout << "\n";
 
     if (all_passed) {